@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    AnalyzerFeed.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "TelemetryFeed.h"
+
+// The dry input, the signal after the fuzz and gate, and the wet tail, summed
+// to mono for the editor's analyser. The audio thread only copies samples
+// into a lock-free FIFO per stream, and only while an analyser is showing;
+// all the analysis happens on the reading side.
+class AnalyzerFeed
+{
+public:
+    enum Stream
+    {
+        dry = 0,
+        fuzzed,
+        wet,
+        numStreams
+    };
+
+    // About 170 ms at 192 kHz, several display frames even at the highest rate.
+    static constexpr int capacity = 1 << 15;
+
+    // Reader thread. The FIFOs are allocated the first time an analyser
+    // opens, so instances that never show one don't pay for them, and kept
+    // from then on, since the audio thread may still be mid-copy when the
+    // analyser closes.
+    void setActive(bool shouldBeActive)
+    {
+        if(! shouldBeActive)
+        {
+            activeFifos.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        if(storage == nullptr)
+            storage.reset(new Fifo[numStreams]);
+
+        for(int stream = 0; stream < numStreams; ++stream)
+            storage[stream].discardAll();
+
+        activeFifos.store(storage.get(), std::memory_order_release);
+    }
+
+    // Audio thread. right is nullptr for mono. Samples that don't fit are
+    // dropped.
+    template <typename SampleType>
+    void write(Stream stream, const SampleType* left, const SampleType* right, int numSamples) noexcept
+    {
+        if(auto* fifos = activeFifos.load(std::memory_order_acquire))
+            fifos[stream].write(left, right, numSamples);
+    }
+
+    // Audio thread. A chunk the processor slept through is silent on every
+    // stream, and a bypassed one on the fuzzed and wet streams, so all three
+    // always get the same number of samples.
+    void writeSilence(int numSamples) noexcept
+    {
+        for(int stream = 0; stream < numStreams; ++stream)
+            writeSilence(static_cast<Stream>(stream), numSamples);
+    }
+
+    void writeSilence(Stream stream, int numSamples) noexcept
+    {
+        if(auto* fifos = activeFifos.load(std::memory_order_acquire))
+            fifos[stream].write<float>(nullptr, nullptr, numSamples);
+    }
+
+    // Zero until an analyser has been opened.
+    size_t getAllocatedBytes() const noexcept {return storage != nullptr ? numStreams * sizeof(Fifo) : 0;}
+
+    // Reader thread. Returns how many samples were copied into destination.
+    int read(Stream stream, float* destination, int maxSamples) noexcept
+    {
+        return storage != nullptr ? storage[stream].read(destination, maxSamples) : 0;
+    }
+
+private:
+    static constexpr uint32_t mask = (uint32_t) capacity - 1;
+
+    struct Fifo
+    {
+        alignas(cacheLineSize) std::atomic<uint32_t> writeIndex {0};
+        alignas(cacheLineSize) std::atomic<uint32_t> readIndex {0};
+        alignas(cacheLineSize) float data[capacity] {};
+
+        template <typename SampleType>
+        void write(const SampleType* left, const SampleType* right, int numSamples) noexcept
+        {
+            const auto write = writeIndex.load(std::memory_order_relaxed);
+            const auto space = (uint32_t) capacity - (write - readIndex.load(std::memory_order_acquire));
+            const auto count = juce::jmin((uint32_t) numSamples, space);
+
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                SampleType sample = 0;
+
+                if(right != nullptr)
+                    sample = (left[i] + right[i]) * SampleType(0.5);
+                else if(left != nullptr)
+                    sample = left[i];
+
+                data[(write + i) & mask] = static_cast<float>(sample);
+            }
+
+            writeIndex.store(write + count, std::memory_order_release);
+        }
+
+        int read(float* destination, int maxSamples) noexcept
+        {
+            const auto read = readIndex.load(std::memory_order_relaxed);
+            const auto count = juce::jmin((uint32_t) maxSamples, writeIndex.load(std::memory_order_acquire) - read);
+
+            for(uint32_t i = 0; i < count; ++i)
+                destination[i] = data[(read + i) & mask];
+
+            readIndex.store(read + count, std::memory_order_release);
+            return (int) count;
+        }
+
+        void discardAll() noexcept
+        {
+            readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<Fifo[]> storage;
+    std::atomic<Fifo*> activeFifos {nullptr};
+};
@@ -28,4 +28,6 @@ void CustomKnob::setDisplayValues(juce::String minLabel, juce::String maxLabel)
 {
     displayMin = std::move(minLabel);
     displayMax = std::move(maxLabel);
+    bodyCache = {};
+    repaint();
 }
@@ -24,8 +24,13 @@ public:
     juce::String getDisplayMin() const {return displayMin;}
     juce::String getDisplayMax() const {return displayMax;}
     
+    // The look and feel's pre-rendered knob body. It checks the size against
+    // the knob's own at the current scale, so a resize invalidates it.
+    juce::Image& getBodyCache() {return bodyCache;}
+    
 private:
     juce::String displayMin, displayMax;
+    juce::Image bodyCache;
     std::unique_ptr<CustomKnobLookAndFeel> lookAndFeel;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomKnob)
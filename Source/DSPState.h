@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    DSPState.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "ReverbEngine.h"
+#include "FuzzStage.h"
+#include "PrecisionFilters.h"
+#include "ModulatedDelayLine.h"
+#include "ParameterSnapshot.h"
+#include "WetStages.h"
+#include "TelemetryFeed.h"
+
+// The delay lines hold audio history, so they exist once per processing
+// precision. Only the one the host asked for is prepared.
+template <typename SampleType>
+struct SampleTypeState
+{
+    juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> bypassDelay;
+    LinearDelayLine<SampleType> preDelayL, preDelayR;
+    ModulatedDelayLine<SampleType> tailModulation;
+};
+
+// Everything one processor instance changes while processing audio. The block
+// starts on a cache line and is padded to whole lines, so instances running
+// on different host threads never write to the same line, and the telemetry
+// ring the editor drains sits apart from it. Read-only data shared between
+// instances lives in SharedTables instead.
+struct alignas(cacheLineSize) DSPState
+{
+    FuzzStage fuzz;
+    float gateEnvelopeL = 0.0f, gateEnvelopeR = 0.0f;
+
+    ReverbEngine reverb;
+
+    // Offline renders and double precision processing run the wet filters
+    // with double precision state.
+    WetFilterBank<float> wetFilters;
+    WetFilterBank<double> precisionWetFilters;
+
+    juce::SmoothedValue<float> tailCutoffL, tailCutoffR;
+    float tailEnvelopeL = 0.0f, tailEnvelopeR = 0.0f;
+
+    ParameterRamp gainRamp, verbRamp, volRamp;
+
+    TelemetryBuilder telemetry;
+
+    SampleTypeState<float> floatPath;
+    SampleTypeState<double> doublePath;
+
+    template <typename SampleType>
+    SampleTypeState<SampleType>& path() noexcept
+    {
+        if constexpr(std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+};
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Branch free float approximations of the transcendental functions used on
+// the audio path. Each one only works on the exponent bits and a short
+// polynomial, so loops over them auto-vectorise. Bounds, checked by
+// Tools/FastMathTest.cpp against the std versions:
+//
+//     log2           abs error < 2e-7 * max(1, |log2 x|)   for normal x > 0
+//     exp2           rel error < 3e-7      for -126 < x < 126
+//     pow            rel error < 4e-6      for 0 < x <= 1, 2 <= y <= 3 and
+//                                          x^y >= 1e-12; < 1e-5 down to
+//                                          x^y = 2^-126, and 0 below that
+//     gainToDecibels abs error < 1.2e-5 dB above the -100 dB floor
+//     tanh           abs error < 3e-7
+//
+// The tail modulation LFO needs no sine at all: it rotates a phasor.
+namespace FastMath
+{
+    inline float bitsToFloat(juce::uint32 bits) noexcept
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    inline juce::uint32 floatToBits(float value) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float log2(float x) noexcept
+    {
+        // Split x into 2^e * m with m in [sqrt(0.5), sqrt(2)), then use the
+        // odd series for log2(m) in u = (m - 1) / (m + 1), |u| < 0.172.
+        const juce::uint32 bits = floatToBits(x);
+        const juce::uint32 shifted = bits - 0x3f3504f3u; // sqrt(0.5)
+        const int exponent = static_cast<int>(shifted) >> 23;
+        const float m = bitsToFloat((shifted & 0x007fffffu) + 0x3f3504f3u);
+
+        const float u = (m - 1.0f) / (m + 1.0f);
+        const float u2 = u * u;
+        const float series = u * (2.8853900818f + u2 * (0.9617966939f + u2 * (0.5770780164f + u2 * 0.4121985831f)));
+
+        return static_cast<float>(exponent) + series;
+    }
+
+    inline float exp2(float x) noexcept
+    {
+        x = juce::jlimit(-126.0f, 126.0f, x);
+
+        // Round to the nearest integer without a library call, then a Taylor
+        // polynomial for 2^f on f in [-0.5, 0.5].
+        const float shifted = x + 0.5f;
+        int whole = static_cast<int>(shifted);
+        whole -= static_cast<float>(whole) > shifted ? 1 : 0;
+        const float f = x - static_cast<float>(whole);
+
+        const float p = 1.0f + f * (0.6931471806f + f * (0.2402265070f + f * (0.0555041087f
+                      + f * (0.0096181291f + f * (0.0013333558f + f * 0.0001540353f)))));
+
+        return p * bitsToFloat(static_cast<juce::uint32>(whole + 127) << 23);
+    }
+
+    // x^y for x >= 0. Returns 0 for x <= 0, and where x^y would be below
+    // 2^-126 instead of sticking at the bottom of the exp2 range.
+    inline float pow(float x, float y) noexcept
+    {
+        const float exponent = y * log2(x);
+        return x > 0.0f && exponent >= -126.0f ? exp2(exponent) : 0.0f;
+    }
+
+    // Same contract as juce::Decibels::gainToDecibels.
+    inline float gainToDecibels(float gain, float minusInfinityDb = -100.0f) noexcept
+    {
+        return gain > 0.0f ? juce::jmax(minusInfinityDb, log2(gain) * 6.0205999133f)
+                           : minusInfinityDb;
+    }
+
+    inline float tanh(float x) noexcept
+    {
+        // tanh(x) = (e^2x - 1) / (e^2x + 1); past |x| = 9 it is 1 in float.
+        x = juce::jlimit(-9.0f, 9.0f, x);
+        const float e = exp2(x * 2.8853900818f);
+        return (e - 1.0f) / (e + 1.0f);
+    }
+}
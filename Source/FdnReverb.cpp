@@ -0,0 +1,379 @@
+/*
+  ==============================================================================
+
+    FdnReverb.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FdnReverb.h"
+#include "SimdLanes.h"
+
+namespace
+{
+    using namespace SimdLanes;
+
+    // Line lengths are spread exponentially over this range and nudged up to
+    // distinct primes, so no two lines share a factor.
+    constexpr double shortestLineMs = 21.0;
+    constexpr double longestLineMs = 67.0;
+
+    // Every line swings this far either side of its length, each at its own
+    // rate within the range.
+    constexpr double modDepthMs = 0.25;
+    constexpr double slowestModHz = 0.1;
+    constexpr double fastestModHz = 0.7;
+
+    // Level matched to StereoReverb at the plugin's settings. Each output
+    // sums half the lines, so the output is also scaled by 1 / sqrt(numLines).
+    constexpr float inputScale = 0.125f;
+    constexpr float outputScale = 8.8f;
+
+    // roomSize 0 to 1 maps to a decay time of 0.25 s to 10 s.
+    double roomSizeToDecaySeconds(float roomSize)
+    {
+        return 0.25 * std::pow(40.0, static_cast<double>(roomSize));
+    }
+
+    int nextPrime(int n)
+    {
+        auto isPrime = [](int x)
+        {
+            if(x < 2)
+                return false;
+
+            for(int d = 2; d * d <= x; ++d)
+            {
+                if(x % d == 0)
+                    return false;
+            }
+
+            return true;
+        };
+
+        while(! isPrime(n))
+            ++n;
+
+        return n;
+    }
+}
+
+template <int numLines>
+FdnReverb<numLines>::FdnReverb()
+{
+    updateCoefficients();
+}
+
+template <int numLines>
+void FdnReverb<numLines>::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    modDepth = static_cast<float>(sampleRate * modDepthMs / 1000.0);
+
+    std::array<int, numLines> lengths {};
+    std::array<int, numLines> sizes {};
+    int totalFloats = 16;
+    int previousLength = 1;
+
+    for(int i = 0; i < numLines; ++i)
+    {
+        const double position = static_cast<double>(i) / (numLines - 1);
+        const double ms = shortestLineMs * std::pow(longestLineMs / shortestLineMs, position);
+
+        lengths[(size_t) i] = nextPrime(juce::jmax(previousLength + 1, juce::roundToInt(sampleRate * ms / 1000.0)));
+        previousLength = lengths[(size_t) i];
+
+        // Room for the modulation and the interpolation tap past the length.
+        sizes[(size_t) i] = juce::nextPowerOfTwo(lengths[(size_t) i] + static_cast<int>(std::ceil(modDepth)) + 2);
+        totalFloats += sizes[(size_t) i];
+    }
+
+    // Power of two sizes keep every line on a 16 float boundary.
+    storage.calloc(static_cast<size_t>(totalFloats));
+    storageSize = totalFloats;
+    clearPosition = 0;
+    float* next = juce::snapPointerToAlignment(storage.get(), 16 * sizeof(float));
+    maxMask = 0;
+
+    for(int i = 0; i < numLines; ++i)
+    {
+        lines[(size_t) i].data = next;
+        lines[(size_t) i].mask = sizes[(size_t) i] - 1;
+        next += sizes[(size_t) i];
+
+        maxMask = juce::jmax(maxMask, lines[(size_t) i].mask);
+        baseDelay[(size_t) i] = static_cast<float>(lengths[(size_t) i]);
+
+        const double rate = slowestModHz + (fastestModHz - slowestModHz) * i / (numLines - 1);
+        const double increment = juce::MathConstants<double>::twoPi * rate / sampleRate;
+        lfoRotationCos[(size_t) i] = static_cast<float>(std::cos(increment));
+        lfoRotationSin[(size_t) i] = static_cast<float>(std::sin(increment));
+    }
+
+    updateCoefficients();
+    reset();
+}
+
+template <int numLines>
+void FdnReverb<numLines>::reset()
+{
+    for(int i = 0; i < numLines; ++i)
+    {
+        if(lines[(size_t) i].data != nullptr)
+            std::fill(lines[(size_t) i].data, lines[(size_t) i].data + lines[(size_t) i].mask + 1, 0.0f);
+    }
+
+    resetState();
+}
+
+template <int numLines>
+bool FdnReverb<numLines>::clearSome(int maxFloats) noexcept
+{
+    const int numToClear = juce::jmin(maxFloats, storageSize - clearPosition);
+
+    if(numToClear > 0)
+    {
+        std::fill(storage.get() + clearPosition, storage.get() + clearPosition + numToClear, 0.0f);
+        clearPosition += numToClear;
+    }
+
+    if(clearPosition < storageSize)
+        return false;
+
+    resetState();
+    return true;
+}
+
+template <int numLines>
+void FdnReverb<numLines>::resetState() noexcept
+{
+    for(int i = 0; i < numLines; ++i)
+    {
+        // Spread the LFO phases around the circle.
+        const double phase = juce::MathConstants<double>::twoPi * i / numLines;
+        lfoSin[(size_t) i] = static_cast<float>(std::sin(phase));
+        lfoCos[(size_t) i] = static_cast<float>(std::cos(phase));
+    }
+
+    lowpassState.fill(0.0f);
+    writeIndex = 0;
+    clearPosition = 0;
+}
+
+template <int numLines>
+void FdnReverb<numLines>::setParameters(const juce::Reverb::Parameters& newParams)
+{
+    parameters = newParams;
+    updateCoefficients();
+}
+
+template <int numLines>
+void FdnReverb<numLines>::setMixing(FdnMixing newMixing) noexcept
+{
+    if(newMixing == mixing)
+        return;
+
+    mixing = newMixing;
+    updateCoefficients();
+}
+
+template <int numLines>
+void FdnReverb<numLines>::updateCoefficients()
+{
+    const bool isFrozen = parameters.freezeMode >= 0.5f;
+    const double decaySeconds = roomSizeToDecaySeconds(parameters.roomSize);
+
+    // The butterflies leave out the 1 / sqrt(numLines) that makes the
+    // Hadamard matrix orthogonal, so it is folded into the line gains.
+    const double mixScale = mixing == FdnMixing::hadamard ? 1.0 / std::sqrt(static_cast<double>(numLines)) : 1.0;
+
+    float meanDelay = 0.0f;
+    for(auto delay : baseDelay)
+        meanDelay += delay / numLines;
+
+    for(size_t i = 0; i < (size_t) numLines; ++i)
+    {
+        // -60 dB after decaySeconds, whatever the line's length.
+        const double gain = isFrozen ? 1.0 : std::pow(10.0, -3.0 * baseDelay[i] / (sampleRate * decaySeconds));
+        decayGain[i] = static_cast<float>(gain * mixScale);
+
+        // Longer lines lose more high end per pass, so the damping is even over time.
+        const float relativeLength = meanDelay > 0.0f ? baseDelay[i] / meanDelay : 1.0f;
+        damping[i] = isFrozen ? 0.0f : juce::jlimit(0.0f, 0.95f, parameters.damping * 0.4f * relativeLength);
+    }
+
+    inputGain = isFrozen ? 0.0f : inputScale;
+    wetGain = 0.5f * parameters.wetLevel * outputScale * (1.0f + parameters.width) / std::sqrt(static_cast<float>(numLines));
+    dryGain = parameters.dryLevel * 2.0f;
+}
+
+template <int numLines>
+template <int numChannels, typename SampleType>
+void FdnReverb<numLines>::process(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    jassert(lines[0].data != nullptr); // prepare() first
+
+    for(int start = 0; start < numSamples; start += blockSize)
+    {
+        const int n = juce::jmin(blockSize, numSamples - start);
+        SampleType* blockLeft = left + start;
+        SampleType* blockRight = numChannels > 1 ? right + start : blockLeft;
+
+        for(int i = 0; i < n; ++i)
+        {
+            blockL[(size_t) i] = static_cast<float>(blockLeft[i]);
+            blockR[(size_t) i] = static_cast<float>(blockRight[i]);
+        }
+
+        if(mixing == FdnMixing::hadamard)
+            processFrames<FdnMixing::hadamard>(n);
+        else
+            processFrames<FdnMixing::householder>(n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            blockLeft[i] = static_cast<SampleType>(blockL[(size_t) i] * wetGain) + blockLeft[i] * dryGain;
+            if constexpr(numChannels > 1)
+                blockRight[i] = static_cast<SampleType>(blockR[(size_t) i] * wetGain) + blockRight[i] * dryGain;
+        }
+    }
+}
+
+template <int numLines>
+template <FdnMixing mode>
+void FdnReverb<numLines>::processFrames(int numSamples) noexcept
+{
+    alignas(16) float delays[numLines];
+    alignas(16) float taps[numLines];
+    alignas(16) float feedback[numLines];
+    alignas(16) float outLanes[4];
+
+    Lanes lowpass[numRegisters], sine[numRegisters], cosine[numRegisters];
+    Lanes rotationSin[numRegisters], rotationCos[numRegisters];
+    Lanes gain[numRegisters], damp[numRegisters], undamp[numRegisters], base[numRegisters];
+
+    for(int r = 0; r < numRegisters; ++r)
+    {
+        lowpass[r] = loadAligned(lowpassState.data() + r * 4);
+        sine[r] = loadAligned(lfoSin.data() + r * 4);
+        cosine[r] = loadAligned(lfoCos.data() + r * 4);
+        rotationSin[r] = loadAligned(lfoRotationSin.data() + r * 4);
+        rotationCos[r] = loadAligned(lfoRotationCos.data() + r * 4);
+        gain[r] = loadAligned(decayGain.data() + r * 4);
+        damp[r] = loadAligned(damping.data() + r * 4);
+        undamp[r] = sub(splat(1.0f), damp[r]);
+        base[r] = loadAligned(baseDelay.data() + r * 4);
+    }
+
+    const Lanes depth = splat(modDepth);
+    const Lanes alternateSigns = lanes(1.0f, -1.0f, 1.0f, -1.0f);
+    const Lanes halfSigns = lanes(1.0f, 1.0f, -1.0f, -1.0f);
+    const Lanes householderScale = splat(2.0f / numLines);
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        // The block holds the input until this frame's output replaces it.
+        const Lanes input = pairs(blockL[(size_t) i] * inputGain, blockR[(size_t) i] * inputGain);
+
+        // === Modulated reads === //
+        for(int r = 0; r < numRegisters; ++r)
+        {
+            storeAligned(delays + r * 4, add(base[r], mul(sine[r], depth)));
+
+            const Lanes nextCos = sub(mul(cosine[r], rotationCos[r]), mul(sine[r], rotationSin[r]));
+            sine[r] = add(mul(sine[r], rotationCos[r]), mul(cosine[r], rotationSin[r]));
+            cosine[r] = nextCos;
+        }
+
+        for(int l = 0; l < numLines; ++l)
+        {
+            const Line& line = lines[(size_t) l];
+            const int delayInt = static_cast<int>(delays[l]);
+            const float delayFrac = delays[l] - static_cast<float>(delayInt);
+
+            const float value1 = line.data[(writeIndex - delayInt) & line.mask];
+            const float value2 = line.data[(writeIndex - delayInt - 1) & line.mask];
+            taps[l] = value1 + delayFrac * (value2 - value1);
+        }
+
+        // === Damping, output taps and decay === //
+        Lanes v[numRegisters];
+        Lanes out = splat(0.0f);
+
+        for(int r = 0; r < numRegisters; ++r)
+        {
+            lowpass[r] = add(mul(loadAligned(taps + r * 4), undamp[r]), mul(lowpass[r], damp[r]));
+            out = (r & 1) != 0 ? sub(out, lowpass[r]) : add(out, lowpass[r]);
+            v[r] = mul(lowpass[r], gain[r]);
+        }
+
+        // Lanes 0 and 2 hold the even lines, 1 and 3 the odd ones.
+        storeAligned(outLanes, out);
+        blockL[(size_t) i] = outLanes[0] - outLanes[2];
+        blockR[(size_t) i] = outLanes[1] - outLanes[3];
+
+        // === Feedback matrix === //
+        if constexpr(mode == FdnMixing::hadamard)
+        {
+            for(int r = 0; r < numRegisters; ++r)
+            {
+                v[r] = add(mul(v[r], alternateSigns), swapPairs(v[r]));
+                v[r] = add(mul(v[r], halfSigns), swapHalves(v[r]));
+            }
+
+            for(int h = 1; h < numRegisters; h *= 2)
+            {
+                for(int j = 0; j < numRegisters; j += h * 2)
+                {
+                    for(int k = j; k < j + h; ++k)
+                    {
+                        const Lanes a = v[k];
+                        v[k] = add(a, v[k + h]);
+                        v[k + h] = sub(a, v[k + h]);
+                    }
+                }
+            }
+        }
+        else
+        {
+            Lanes total = v[0];
+            for(int r = 1; r < numRegisters; ++r)
+                total = add(total, v[r]);
+
+            total = mul(sumAcross(total), householderScale);
+
+            for(int r = 0; r < numRegisters; ++r)
+                v[r] = sub(v[r], total);
+        }
+
+        // === Input and writes === //
+        for(int r = 0; r < numRegisters; ++r)
+            storeAligned(feedback + r * 4, add(v[r], input));
+
+        for(int l = 0; l < numLines; ++l)
+            lines[(size_t) l].data[writeIndex & lines[(size_t) l].mask] = feedback[l];
+
+        writeIndex = (writeIndex + 1) & maxMask;
+    }
+
+    for(int r = 0; r < numRegisters; ++r)
+    {
+        // One Newton step keeps the LFO phasors at unit length.
+        const Lanes correction = sub(splat(1.5f), mul(splat(0.5f), add(mul(sine[r], sine[r]), mul(cosine[r], cosine[r]))));
+        storeAligned(lfoSin.data() + r * 4, mul(sine[r], correction));
+        storeAligned(lfoCos.data() + r * 4, mul(cosine[r], correction));
+        storeAligned(lowpassState.data() + r * 4, lowpass[r]);
+    }
+}
+
+template class FdnReverb<8>;
+template class FdnReverb<16>;
+template void FdnReverb<8>::process<1>(float*, float*, int) noexcept;
+template void FdnReverb<8>::process<2>(float*, float*, int) noexcept;
+template void FdnReverb<8>::process<1>(double*, double*, int) noexcept;
+template void FdnReverb<8>::process<2>(double*, double*, int) noexcept;
+template void FdnReverb<16>::process<1>(float*, float*, int) noexcept;
+template void FdnReverb<16>::process<2>(float*, float*, int) noexcept;
+template void FdnReverb<16>::process<1>(double*, double*, int) noexcept;
+template void FdnReverb<16>::process<2>(double*, double*, int) noexcept;
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    FdnReverb.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+enum class FdnMixing
+{
+    hadamard,
+    householder
+};
+
+// Feedback delay network with numLines modulated delay lines. Each line has
+// its own decay gain, set from its length so every line falls by the same
+// amount per second, and its own one-pole damping. The lines are fed back
+// through an orthogonal matrix:
+//
+//   hadamard     every line feeds every other with equal weight, as a fast
+//                Walsh-Hadamard butterfly. Dense from the first reflections.
+//   householder  each line keeps most of itself and hands the rest on
+//                evenly. Cheaper and builds up density more slowly.
+//
+// The per-line work runs four lines to a SIMD register, so numLines picks
+// CPU against density at compile time. Only the delay line reads and writes
+// are scalar. Even lines take the left input and odd lines the right.
+//
+// Same interface as StereoReverb. The network always runs in float.
+template <int numLines>
+class FdnReverb
+{
+public:
+    static_assert(numLines >= 4 && (numLines & (numLines - 1)) == 0, "numLines must be a power of two, at least 4");
+
+    FdnReverb();
+
+    void prepare(double sampleRate);
+    void reset();
+    bool clearSome(int maxFloats) noexcept;
+
+    // Of the delay lines, which scale with the sample rate.
+    size_t getAllocatedBytes() const noexcept {return (size_t) storageSize * sizeof(float);}
+
+    // roomSize sets the decay time and damping the high frequency loss per
+    // line. Changes apply from the next process() call.
+    void setParameters(const juce::Reverb::Parameters& newParams);
+    const juce::Reverb::Parameters& getParameters() const {return parameters;}
+
+    void setMixing(FdnMixing newMixing) noexcept;
+    FdnMixing getMixing() const noexcept {return mixing;}
+
+    template <int numChannels, typename SampleType>
+    void process(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    static constexpr int numRegisters = numLines / 4;
+
+    struct Line
+    {
+        float* data = nullptr;
+        int mask = 0;
+    };
+
+    void updateCoefficients();
+    void resetState() noexcept;
+
+    // Runs the network over blockL / blockR, replacing the input with the
+    // network output.
+    template <FdnMixing mode>
+    void processFrames(int numSamples) noexcept;
+
+    juce::Reverb::Parameters parameters;
+    FdnMixing mixing = FdnMixing::hadamard;
+    double sampleRate = 44100.0;
+
+    juce::HeapBlock<float> storage;
+    int storageSize = 0;
+    int clearPosition = 0;
+    std::array<Line, numLines> lines;
+    int writeIndex = 0;
+    int maxMask = 0; // every line's mask divides it, so one index serves all
+
+    // One entry per line, grouped four to a register.
+    alignas(16) std::array<float, numLines> baseDelay {};
+    alignas(16) std::array<float, numLines> decayGain {};
+    alignas(16) std::array<float, numLines> damping {};
+    alignas(16) std::array<float, numLines> lowpassState {};
+    alignas(16) std::array<float, numLines> lfoSin {}, lfoCos {};
+    alignas(16) std::array<float, numLines> lfoRotationSin {}, lfoRotationCos {};
+
+    float modDepth = 0.0f;
+    float inputGain = 0.0f;
+    float wetGain = 0.0f, dryGain = 0.0f;
+
+    // The network runs in blocks of this size on float copies of the audio.
+    static constexpr int blockSize = 64;
+    alignas(16) std::array<float, blockSize> blockL {}, blockR {};
+};
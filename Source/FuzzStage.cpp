@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    FuzzStage.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FuzzStage.h"
+#include "FastMath.h"
+
+template <typename SampleType>
+void FuzzStage::Path<SampleType>::prepare(int numChannels, int maxBlockSize)
+{
+    using Oversampler = juce::dsp::Oversampling<SampleType>;
+
+    for(size_t i = 0; i < oversamplers.size(); ++i)
+    {
+        oversamplers[i] = std::make_unique<Oversampler>(static_cast<size_t>(juce::jmax(1, numChannels)),
+                                                        i + 1,
+                                                        Oversampler::filterHalfBandPolyphaseIIR,
+                                                        true,
+                                                        true);
+        oversamplers[i]->initProcessing(static_cast<size_t>(maxBlockSize));
+    }
+
+    fadeBuffer.setSize(juce::jmax(1, numChannels), maxBlockSize);
+}
+
+template <typename SampleType>
+void FuzzStage::Path<SampleType>::release()
+{
+    for(auto& oversampler : oversamplers)
+        oversampler.reset();
+
+    fadeBuffer.setSize(0, 0);
+}
+
+template <typename SampleType>
+size_t FuzzStage::Path<SampleType>::getAllocatedBytes() const noexcept
+{
+    const size_t blockBytes = (size_t) (fadeBuffer.getNumChannels() * fadeBuffer.getNumSamples()) * sizeof(SampleType);
+    size_t total = blockBytes;
+
+    for(size_t i = 0; i < oversamplers.size(); ++i)
+    {
+        if(oversamplers[i] != nullptr)
+            total += blockBytes * (((size_t) 2 << (i + 1)) - 2);
+    }
+
+    return total;
+}
+
+void FuzzStage::prepare(int numChannels, int maxBlockSize, bool doublePrecision)
+{
+    usingDoublePrecision = doublePrecision;
+
+    if(doublePrecision)
+    {
+        doublePath.prepare(numChannels, maxBlockSize);
+        floatPath.release();
+    }
+    else
+    {
+        floatPath.prepare(numChannels, maxBlockSize);
+        doublePath.release();
+    }
+
+    reset();
+}
+
+size_t FuzzStage::getAllocatedBytes() const noexcept
+{
+    return floatPath.getAllocatedBytes() + doublePath.getAllocatedBytes();
+}
+
+void FuzzStage::reset()
+{
+    for(auto& oversampler : floatPath.oversamplers)
+    {
+        if(oversampler != nullptr)
+            oversampler->reset();
+    }
+
+    for(auto& oversampler : doublePath.oversamplers)
+    {
+        if(oversampler != nullptr)
+            oversampler->reset();
+    }
+
+    crossfadeSamplesLeft = 0;
+}
+
+void FuzzStage::setQuality(int newQuality, bool crossfade)
+{
+    newQuality = juce::jlimit(0, numQualities - 1, newQuality);
+
+    if(newQuality == quality)
+        return;
+
+    previousQuality = quality;
+    quality = newQuality;
+    crossfadeSamplesLeft = crossfade ? crossfadeLength : 0;
+
+    if(quality == off)
+        return;
+
+    if(auto& oversampler = floatPath.oversamplers[(size_t) quality - 1])
+        oversampler->reset();
+
+    if(auto& oversampler = doublePath.oversamplers[(size_t) quality - 1])
+        oversampler->reset();
+}
+
+float FuzzStage::getOversamplerLatency(int qualityToUse) const
+{
+    if(qualityToUse == off)
+        return 0.0f;
+
+    const size_t index = (size_t) qualityToUse - 1;
+
+    if(usingDoublePrecision)
+        return doublePath.oversamplers[index] != nullptr ? static_cast<float>(doublePath.oversamplers[index]->getLatencyInSamples()) : 0.0f;
+
+    return floatPath.oversamplers[index] != nullptr ? static_cast<float>(floatPath.oversamplers[index]->getLatencyInSamples()) : 0.0f;
+}
+
+int FuzzStage::getLatencyInSamples() const
+{
+    return juce::roundToInt(getOversamplerLatency(quality));
+}
+
+int FuzzStage::getMaxLatencyInSamples() const
+{
+    int maxLatency = 0;
+
+    for(int q = x2; q < numQualities; ++q)
+        maxLatency = juce::jmax(maxLatency, juce::roundToInt(getOversamplerLatency(q)));
+
+    return maxLatency;
+}
+
+FuzzStage::Drive FuzzStage::getDrive(float gain) noexcept
+{
+    for(const auto& cached : recentDrives)
+    {
+        if(cached.gain == gain)
+            return cached;
+    }
+
+    const float shaped = FastMath::pow(gain, 2.2f);
+
+    auto& drive = recentDrives[(size_t) nextDriveSlot];
+    drive.gain = gain;
+    drive.drive1 = juce::jmap(shaped, 1.0f, 8.0f);
+    drive.drive2 = juce::jmap(shaped, 1.0f, 2.5f);
+
+    nextDriveSlot ^= 1;
+    return drive;
+}
+
+template <typename SampleType>
+void FuzzStage::process(juce::AudioBuffer<SampleType>& buffer, float startGain, float endGain) noexcept
+{
+    const Drive start = getDrive(startGain);
+    const Drive end = getDrive(endGain);
+
+    if(crossfadeSamplesLeft <= 0)
+    {
+        processWithQuality(buffer, quality, start, end);
+        return;
+    }
+
+    // Run the outgoing path on a copy and ramp from it to the new one.
+    auto& outgoing = getPath<SampleType>().fadeBuffer;
+    outgoing.makeCopyOf(buffer, true);
+
+    processWithQuality(outgoing, previousQuality, start, end);
+    processWithQuality(buffer, quality, start, end);
+
+    const int numSamples = buffer.getNumSamples();
+    const float step = 1.0f / static_cast<float>(crossfadeLength);
+    const float startFade = 1.0f - static_cast<float>(crossfadeSamplesLeft) * step;
+
+    for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* channelData = buffer.getWritePointer(channel);
+        auto* oldData = outgoing.getReadPointer(channel);
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            const SampleType fade = juce::jmin(1.0f, startFade + static_cast<float>(i + 1) * step);
+            channelData[i] = oldData[i] + fade * (channelData[i] - oldData[i]);
+        }
+    }
+
+    crossfadeSamplesLeft -= numSamples;
+}
+
+template <typename SampleType>
+void FuzzStage::processWithQuality(juce::AudioBuffer<SampleType>& buffer, int qualityToUse,
+                                   const Drive& start, const Drive& end) noexcept
+{
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    auto& oversamplers = getPath<SampleType>().oversamplers;
+
+    if(qualityToUse == off || oversamplers[(size_t) qualityToUse - 1] == nullptr)
+    {
+        for(int channel = 0; channel < numChannels; ++channel)
+            clip(buffer.getWritePointer(channel), numSamples, start, end);
+
+        return;
+    }
+
+    auto& oversampler = *oversamplers[(size_t) qualityToUse - 1];
+
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    auto oversampledBlock = oversampler.processSamplesUp(block);
+
+    for(size_t channel = 0; channel < oversampledBlock.getNumChannels(); ++channel)
+        clip(oversampledBlock.getChannelPointer(channel),
+             static_cast<int>(oversampledBlock.getNumSamples()), start, end);
+
+    oversampler.processSamplesDown(block);
+}
+
+template <typename SampleType>
+void FuzzStage::clip(SampleType* samples, int numSamples, const Drive& start, const Drive& end) noexcept
+{
+    auto softClip = [](SampleType x) { return x / (SampleType(1) + std::abs(x)); };
+    auto hardClip = [](SampleType x) { return juce::jlimit(SampleType(-0.4f), SampleType(0.4f), x); };
+
+    if(start.gain == end.gain)
+    {
+        const SampleType gain = start.gain;
+        const SampleType drive1 = start.drive1;
+        const SampleType drive2 = start.drive2;
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            SampleType sample = samples[i];
+
+            SampleType stage1 = softClip(sample * drive1);
+            SampleType stage2 = hardClip(stage1 * drive2);
+            samples[i] = juce::jmap(gain, sample, stage2);
+        }
+
+        return;
+    }
+
+    // GAIN is moving: ramp the mix and both drive amounts together.
+    const float step = 1.0f / static_cast<float>(numSamples);
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        const float t = step * static_cast<float>(i + 1);
+        const SampleType gain = start.gain + t * (end.gain - start.gain);
+        const SampleType drive1 = start.drive1 + t * (end.drive1 - start.drive1);
+        const SampleType drive2 = start.drive2 + t * (end.drive2 - start.drive2);
+
+        SampleType sample = samples[i];
+
+        SampleType stage1 = softClip(sample * drive1);
+        SampleType stage2 = hardClip(stage1 * drive2);
+        samples[i] = juce::jmap(gain, sample, stage2);
+    }
+}
+
+template void FuzzStage::process(juce::AudioBuffer<float>&, float, float) noexcept;
+template void FuzzStage::process(juce::AudioBuffer<double>&, float, float) noexcept;
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    FuzzStage.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// The op amp style soft clip -> hard clip drive, optionally run inside
+// polyphase half-band oversampling to keep high GAIN settings from aliasing.
+class FuzzStage
+{
+public:
+    enum Quality
+    {
+        off = 0,
+        x2,
+        x4,
+        x8,
+        numQualities
+    };
+
+    static juce::StringArray getQualityNames() {return {"Off", "2x", "4x", "8x"};}
+
+    // Builds the oversamplers for float or for double audio. Only that
+    // sample type can be processed until the next prepare().
+    void prepare(int numChannels, int maxBlockSize, bool doublePrecision = false);
+    void reset();
+
+    // Safe to call from the audio thread: every oversampler is built in prepare().
+    // With crossfade on, the old and new paths are blended over a short ramp.
+    void setQuality(int newQuality, bool crossfade = true);
+    int getQuality() const {return quality;}
+
+    // True when process() would leave the buffer untouched.
+    bool isPassThrough(float gain) const
+    {
+        return gain <= 0.0001f && quality == off && crossfadeSamplesLeft <= 0;
+    }
+
+    int getLatencyInSamples() const;
+    int getMaxLatencyInSamples() const;
+
+    // juce::dsp::Oversampling doesn't report its buffers, so each of its
+    // stages is counted as one block per channel at that stage's rate.
+    size_t getAllocatedBytes() const noexcept;
+
+    // Drives the buffer in place, ramping GAIN linearly from startGain to
+    // endGain across the block. With oversampling on, the buffer always goes
+    // through the filters so the latency stays constant at GAIN 0.
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, float startGain, float endGain) noexcept;
+
+private:
+    // Everything that holds audio, for one sample type.
+    template <typename SampleType>
+    struct Path
+    {
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, numQualities - 1> oversamplers;
+        juce::AudioBuffer<SampleType> fadeBuffer;
+
+        void prepare(int numChannels, int maxBlockSize);
+        void release();
+        size_t getAllocatedBytes() const noexcept;
+    };
+
+    template <typename SampleType>
+    Path<SampleType>& getPath() noexcept
+    {
+        if constexpr(std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+
+    // Of whichever path was prepared.
+    float getOversamplerLatency(int qualityToUse) const;
+
+    struct Drive
+    {
+        float gain = -1.0f;
+        float drive1 = 1.0f;
+        float drive2 = 1.0f;
+    };
+
+    // The pow() behind the drive amounts only reruns for a GAIN not among
+    // the last two. While GAIN ramps, each piece starts where the last one
+    // ended, so that is once per piece, and never while it holds still.
+    Drive getDrive(float gain) noexcept;
+
+    template <typename SampleType>
+    void processWithQuality(juce::AudioBuffer<SampleType>& buffer, int qualityToUse,
+                            const Drive& start, const Drive& end) noexcept;
+
+    template <typename SampleType>
+    static void clip(SampleType* samples, int numSamples, const Drive& start, const Drive& end) noexcept;
+
+    static constexpr int crossfadeLength = 512;
+
+    Path<float> floatPath;
+    Path<double> doublePath;
+    bool usingDoublePrecision = false;
+
+    int quality = off;
+    int previousQuality = off;
+    int crossfadeSamplesLeft = 0;
+    std::array<Drive, 2> recentDrives;
+    int nextDriveSlot = 0;
+};
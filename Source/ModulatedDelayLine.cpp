@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    ModulatedDelayLine.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ModulatedDelayLine.h"
+
+// === QuadratureLFO === //
+void QuadratureLFO::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    const float rate = rateHz;
+    rateHz = -1.0f;
+    setRate(rate);
+
+    reset();
+}
+
+void QuadratureLFO::reset() noexcept
+{
+    phasorCos = 1.0;
+    phasorSin = 0.0;
+    samplesUntilRenormalise = renormaliseInterval;
+}
+
+void QuadratureLFO::setRate(float newRateHz) noexcept
+{
+    if(newRateHz == rateHz)
+        return;
+
+    rateHz = newRateHz;
+
+    const double increment = juce::MathConstants<double>::twoPi * rateHz / sampleRate;
+    rotationCos = std::cos(increment);
+    rotationSin = std::sin(increment);
+}
+
+void QuadratureLFO::process(float* sine, float* cosine, int numSamples) noexcept
+{
+    double c = phasorCos;
+    double s = phasorSin;
+    int done = 0;
+
+    while(done < numSamples)
+    {
+        const int runLength = juce::jmin(numSamples - done, samplesUntilRenormalise);
+
+        for(int i = done; i < done + runLength; ++i)
+        {
+            sine[i] = static_cast<float>(s);
+            cosine[i] = static_cast<float>(c);
+
+            const double nextCos = c * rotationCos - s * rotationSin;
+            s = s * rotationCos + c * rotationSin;
+            c = nextCos;
+        }
+
+        done += runLength;
+
+        if((samplesUntilRenormalise -= runLength) <= 0)
+        {
+            // One Newton step towards unit length.
+            const double correction = 1.5 - 0.5 * (c * c + s * s);
+            c *= correction;
+            s *= correction;
+            samplesUntilRenormalise = renormaliseInterval;
+        }
+    }
+
+    phasorCos = c;
+    phasorSin = s;
+}
+
+// === ModulatedDelayLine === //
+template <typename SampleType>
+void ModulatedDelayLine<SampleType>::prepare(double sampleRate, int maxDelayInSamples, int maxBlockSize)
+{
+    maxDelay = juce::jmax(1, maxDelayInSamples);
+    maxBlock = juce::jmax(1, maxBlockSize);
+
+    // Room for the Lagrange taps past the maximum delay, two samples per frame.
+    const int size = juce::nextPowerOfTwo(maxDelay + 4);
+    buffer.assign((size_t) size * 2, SampleType());
+    mask = size - 1;
+
+    delayTimesL.allocate((size_t) maxBlock, true);
+    delayTimesR.allocate((size_t) maxBlock, true);
+
+    depthRampLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.02));
+
+    lfo.prepare(sampleRate);
+
+    reset();
+}
+
+template <typename SampleType>
+void ModulatedDelayLine<SampleType>::reset()
+{
+    std::fill(buffer.begin(), buffer.end(), SampleType());
+    writeIndex = 0;
+
+    lastOutput[0] = lastOutput[1] = SampleType();
+    depth = targetDepth;
+    depthStepsLeft = 0;
+
+    lfo.reset();
+}
+
+template <typename SampleType>
+void ModulatedDelayLine<SampleType>::setDepth(float newDepthInSamples) noexcept
+{
+    if(newDepthInSamples == targetDepth)
+        return;
+
+    targetDepth = newDepthInSamples;
+    depthOrigin = depth;
+    depthStep = (targetDepth - depthOrigin) / static_cast<float>(depthRampLength);
+    depthStepsLeft = depthRampLength;
+}
+
+template <typename SampleType>
+template <int numChannels>
+void ModulatedDelayLine<SampleType>::renderDelayTimes(int numSamples) noexcept
+{
+    float* timesL = delayTimesL.get();
+    float* timesR = delayTimesR.get();
+
+    lfo.process(timesL, timesR, numSamples);
+
+    const float limit = static_cast<float>(maxDelay);
+    const float centre = centreDelay;
+
+    if(depthStepsLeft <= 0)
+    {
+        const float d = depth;
+
+        for(int i = 0; i < numSamples; ++i)
+            timesL[i] = juce::jlimit(0.0f, limit, centre + timesL[i] * d);
+
+        if constexpr(numChannels > 1)
+            for(int i = 0; i < numSamples; ++i)
+                timesR[i] = juce::jlimit(0.0f, limit, centre + timesR[i] * d);
+
+        return;
+    }
+
+    // Worked out from where the glide started, like ParameterRamp, so it
+    // doesn't depend on how the samples are split into calls.
+    const int stepsDone = depthRampLength - depthStepsLeft;
+    auto depthAt = [&](int i)
+    {
+        const int step = stepsDone + i + 1;
+        return step < depthRampLength ? depthOrigin + depthStep * static_cast<float>(step) : targetDepth;
+    };
+
+    for(int i = 0; i < numSamples; ++i)
+        timesL[i] = juce::jlimit(0.0f, limit, centre + timesL[i] * depthAt(i));
+
+    if constexpr(numChannels > 1)
+        for(int i = 0; i < numSamples; ++i)
+            timesR[i] = juce::jlimit(0.0f, limit, centre + timesR[i] * depthAt(i));
+
+    depth = depthAt(numSamples - 1);
+    depthStepsLeft = juce::jmax(0, depthStepsLeft - numSamples);
+}
+
+template <typename SampleType>
+template <int numChannels>
+void ModulatedDelayLine<SampleType>::process(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    // The delay times are rendered for at most maxBlock samples at a time.
+    while(numSamples > 0)
+    {
+        const int n = juce::jmin(numSamples, maxBlock);
+
+        renderDelayTimes<numChannels>(n);
+
+        switch(interpolation)
+        {
+            case Interpolation::linear:      processFrames<numChannels, Interpolation::linear>(left, right, n); break;
+            case Interpolation::lagrange3rd: processFrames<numChannels, Interpolation::lagrange3rd>(left, right, n); break;
+            case Interpolation::allpass:     processFrames<numChannels, Interpolation::allpass>(left, right, n); break;
+        }
+
+        left += n;
+        if constexpr(numChannels > 1)
+            right += n;
+        numSamples -= n;
+    }
+}
+
+template <typename SampleType>
+template <int numChannels, DelayInterpolation mode>
+void ModulatedDelayLine<SampleType>::processFrames(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    const float* timesL = delayTimesL.get();
+    const float* timesR = delayTimesR.get();
+
+    auto read = [this](int channel, float delay)
+    {
+        if constexpr(mode == Interpolation::linear)
+            return readLinear(channel, delay);
+        else if constexpr(mode == Interpolation::lagrange3rd)
+            return readLagrange(channel, delay);
+        else
+            return readAllpass(channel, delay);
+    };
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        // A mono block leaves the right half of each frame unused.
+        SampleType* frame = buffer.data() + ((size_t) writeIndex << 1);
+        frame[0] = left[i];
+        if constexpr(numChannels > 1)
+            frame[1] = right[i];
+
+        left[i] = read(0, timesL[i]);
+        if constexpr(numChannels > 1)
+            right[i] = read(1, timesR[i]);
+
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    if constexpr(mode != Interpolation::allpass)
+    {
+        lastOutput[0] = left[numSamples - 1];
+        if constexpr(numChannels > 1)
+            lastOutput[1] = right[numSamples - 1];
+    }
+}
+
+template class ModulatedDelayLine<float>;
+template class ModulatedDelayLine<double>;
+template void ModulatedDelayLine<float>::process<1>(float*, float*, int) noexcept;
+template void ModulatedDelayLine<float>::process<2>(float*, float*, int) noexcept;
+template void ModulatedDelayLine<double>::process<1>(double*, double*, int) noexcept;
+template void ModulatedDelayLine<double>::process<2>(double*, double*, int) noexcept;
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    ModulatedDelayLine.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Sine and cosine LFO from a unit phasor rotated once per sample. The
+// rotation is only recomputed when the rate changes, and the phasor is
+// renormalised every renormaliseInterval samples, counted across calls, so
+// the output doesn't depend on how it is split into calls. It runs in
+// double: at slow rates the float rotation rounds to a visible phase drift
+// within seconds.
+class QuadratureLFO
+{
+public:
+    static constexpr int renormaliseInterval = 32;
+
+    void prepare(double newSampleRate);
+    void reset() noexcept;
+
+    void setRate(float newRateHz) noexcept;
+
+    // Writes the next numSamples values, starting at phase 0 after reset().
+    void process(float* sine, float* cosine, int numSamples) noexcept;
+
+private:
+    double sampleRate = 44100.0;
+    float rateHz = 0.0f;
+
+    double rotationCos = 1.0, rotationSin = 0.0;
+    double phasorCos = 1.0, phasorSin = 0.0;
+    int samplesUntilRenormalise = renormaliseInterval;
+};
+
+enum class DelayInterpolation
+{
+    linear,
+    lagrange3rd,
+    allpass
+};
+
+// Stereo modulated delay for the tail. Both channels are written as one
+// interleaved frame into a single circular buffer, and a whole block is
+// processed per call: the LFO and the delay times are rendered first, then
+// each channel reads at its own time. The left channel follows the sine and
+// the right the cosine of the LFO.
+//
+// The interpolation can be changed while running: every mode reads the same
+// history, and the allpass state always holds the last output, so switching
+// is seamless.
+//
+// SampleType is the type of the audio and of the stored history; the LFO
+// and the delay times are float either way.
+template <typename SampleType>
+class ModulatedDelayLine
+{
+public:
+    using Interpolation = DelayInterpolation;
+
+    void prepare(double sampleRate, int maxDelayInSamples, int maxBlockSize);
+    void reset();
+
+    void setInterpolation(Interpolation newInterpolation) {interpolation = newInterpolation;}
+    Interpolation getInterpolation() const {return interpolation;}
+
+    int getMaximumDelayInSamples() const {return maxDelay;}
+
+    // The history and the per-block delay times.
+    size_t getAllocatedBytes() const noexcept
+    {
+        return buffer.capacity() * sizeof(SampleType) + (size_t) maxBlock * 2 * sizeof(float);
+    }
+
+    // The delay swings depth samples either side of centre, clipped to
+    // 0 and the maximum delay. Depth changes glide over 20 ms.
+    void setCentreDelay(float newCentreInSamples) noexcept {centreDelay = newCentreInSamples;}
+    void setDepth(float newDepthInSamples) noexcept;
+    void setRate(float newRateHz) noexcept {lfo.setRate(newRateHz);}
+
+    // In place. numChannels is 1 or 2; a mono block ignores right, which may
+    // be nullptr. Blocks longer than prepared for run in pieces.
+    template <int numChannels>
+    void process(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    template <int numChannels>
+    void renderDelayTimes(int numSamples) noexcept;
+
+    template <int numChannels, Interpolation mode>
+    void processFrames(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    SampleType tap(int channel, int samplesBack) const noexcept
+    {
+        return buffer[(size_t) ((((writeIndex - samplesBack) & mask) << 1) + channel)];
+    }
+
+    SampleType readLinear(int channel, float delay) const noexcept
+    {
+        const int delayInt = static_cast<int>(delay);
+        const float delayFrac = delay - static_cast<float>(delayInt);
+
+        const SampleType value1 = tap(channel, delayInt);
+        const SampleType value2 = tap(channel, delayInt + 1);
+
+        return value1 + delayFrac * (value2 - value1);
+    }
+
+    SampleType readLagrange(int channel, float delay) const noexcept
+    {
+        int delayInt = static_cast<int>(delay);
+        float delayFrac = delay - static_cast<float>(delayInt);
+
+        // Centre the four taps around the read point where possible.
+        if(delayInt >= 1)
+        {
+            delayFrac += 1.0f;
+            --delayInt;
+        }
+
+        const SampleType value1 = tap(channel, delayInt);
+        const SampleType value2 = tap(channel, delayInt + 1);
+        const SampleType value3 = tap(channel, delayInt + 2);
+        const SampleType value4 = tap(channel, delayInt + 3);
+
+        const float d1 = delayFrac - 1.0f;
+        const float d2 = delayFrac - 2.0f;
+        const float d3 = delayFrac - 3.0f;
+
+        const float c1 = -d1 * d2 * d3 / 6.0f;
+        const float c2 = d2 * d3 * 0.5f;
+        const float c3 = -d1 * d3 * 0.5f;
+        const float c4 = d1 * d2 / 6.0f;
+
+        return value1 * c1 + delayFrac * (value2 * c2 + value3 * c3 + value4 * c4);
+    }
+
+    SampleType readAllpass(int channel, float delay) noexcept
+    {
+        // Below a sample the fraction can't be moved up, and as it goes to 0
+        // the pole goes to -1 on the unit circle. The swing often clips to a
+        // delay of 0, so this mode never reads closer than 1.
+        delay = juce::jmax(1.0f, delay);
+
+        int delayInt = static_cast<int>(delay);
+        float delayFrac = delay - static_cast<float>(delayInt);
+
+        // Keep the fraction above 0.618, where the first order allpass has
+        // the flattest group delay.
+        if(delayFrac < 0.618f)
+        {
+            delayFrac += 1.0f;
+            --delayInt;
+        }
+
+        const float alpha = (1.0f - delayFrac) / (1.0f + delayFrac);
+        const SampleType result = tap(channel, delayInt + 1) + alpha * (tap(channel, delayInt) - lastOutput[channel]);
+
+        lastOutput[channel] = result;
+        return result;
+    }
+
+    QuadratureLFO lfo;
+
+    std::vector<SampleType> buffer;
+    juce::HeapBlock<float> delayTimesL, delayTimesR;
+    int maxBlock = 0;
+    int mask = 0;
+    int writeIndex = 0;
+    int maxDelay = 0;
+
+    float centreDelay = 0.0f;
+    float depth = 0.0f, targetDepth = 0.0f;
+    float depthOrigin = 0.0f, depthStep = 0.0f;
+    int depthRampLength = 1, depthStepsLeft = 0;
+    SampleType lastOutput[2] = {};
+
+    Interpolation interpolation = Interpolation::linear;
+};
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+// === ParameterCache === //
+ParameterCache::ParameterCache(juce::AudioProcessorValueTreeState& apvts)
+    : vol(*apvts.getRawParameterValue("VOL")),
+      gain(*apvts.getRawParameterValue("GAIN")),
+      verb(*apvts.getRawParameterValue("VERB")),
+      darkLight(*apvts.getRawParameterValue("DARK_LIGHT")),
+      bypass(*apvts.getRawParameterValue("BYPASS")),
+      fuzzQuality(*apvts.getRawParameterValue("FUZZ_QUALITY")),
+      modRate(*apvts.getRawParameterValue("MOD_RATE")),
+      modDepth(*apvts.getRawParameterValue("MOD_DEPTH")),
+      reverbEngine(*apvts.getRawParameterValue("REVERB_ENGINE")),
+      fdnMixing(*apvts.getRawParameterValue("FDN_MIXING"))
+{
+    snapshot.volGain = juce::Decibels::decibelsToGain(snapshot.volDb);
+}
+
+const ParameterSnapshot& ParameterCache::update() noexcept
+{
+    const float newVolDb = vol.load();
+    if(newVolDb != snapshot.volDb)
+    {
+        snapshot.volDb = newVolDb;
+        snapshot.volGain = juce::Decibels::decibelsToGain(newVolDb);
+    }
+
+    snapshot.gain = gain.load();
+    snapshot.verb = verb.load();
+    snapshot.darkLight = darkLight.load();
+    snapshot.bypass = bypass.load() >= 0.5f;
+    snapshot.fuzzQuality = static_cast<int>(fuzzQuality.load());
+    snapshot.modRate = modRate.load();
+    snapshot.modDepth = modDepth.load();
+    snapshot.reverbEngine = static_cast<int>(reverbEngine.load());
+    snapshot.fdnMixing = static_cast<int>(fdnMixing.load());
+
+    return snapshot;
+}
+
+// === ParameterRamp === //
+void ParameterRamp::prepare(double sampleRate, int maxBlockSize, double rampSeconds)
+{
+    maxSamples = juce::jmax(1, maxBlockSize);
+    values.allocate(static_cast<size_t>(maxSamples), true);
+    rampLength = juce::jmax(1, juce::roundToInt(sampleRate * rampSeconds));
+
+    setCurrentAndTarget(target);
+}
+
+void ParameterRamp::setCurrentAndTarget(float newValue) noexcept
+{
+    current = target = blockStart = blockEnd = newValue;
+    stepsLeft = 0;
+    rampingInBlock = false;
+}
+
+void ParameterRamp::setTarget(float newTarget) noexcept
+{
+    if(newTarget == target)
+        return;
+
+    target = newTarget;
+    origin = current;
+    step = (target - origin) / static_cast<float>(rampLength);
+    stepsLeft = rampLength;
+}
+
+void ParameterRamp::advance(int numSamples) noexcept
+{
+    jassert(numSamples <= maxSamples);
+    numSamples = juce::jmin(numSamples, maxSamples);
+
+    blockStart = current;
+    float* dest = values.get();
+
+    if(stepsLeft <= 0)
+    {
+        juce::FloatVectorOperations::fill(dest, current, numSamples);
+        rampingInBlock = false;
+        blockEnd = current;
+        return;
+    }
+
+    const int rampSamples = juce::jmin(numSamples, stepsLeft);
+    const int stepsDone = rampLength - stepsLeft;
+
+    for(int i = 0; i < rampSamples; ++i)
+        dest[i] = origin + step * static_cast<float>(stepsDone + i + 1);
+
+    stepsLeft -= rampSamples;
+    current = stepsLeft > 0 ? dest[rampSamples - 1] : target;
+    dest[rampSamples - 1] = current;
+
+    juce::FloatVectorOperations::fill(dest + rampSamples, current, numSamples - rampSamples);
+
+    rampingInBlock = true;
+    blockEnd = current;
+}
+
+void ParameterRamp::applyGain(float* samples, int numSamples) const noexcept
+{
+    if(rampingInBlock)
+        juce::FloatVectorOperations::multiply(samples, values.get(), numSamples);
+    else
+        juce::FloatVectorOperations::multiply(samples, blockEnd, numSamples);
+}
+
+void ParameterRamp::applyGain(double* samples, int numSamples) const noexcept
+{
+    if(! rampingInBlock)
+    {
+        juce::FloatVectorOperations::multiply(samples, static_cast<double>(blockEnd), numSamples);
+        return;
+    }
+
+    const float* gains = values.get();
+
+    for(int i = 0; i < numSamples; ++i)
+        samples[i] *= gains[i];
+}
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Every parameter as processBlock sees it, read once per control sub-block.
+struct ParameterSnapshot
+{
+    float volDb = 0.0f;
+    float volGain = 1.0f;
+    float gain = 0.0f;
+    float verb = 0.0f;
+    float darkLight = 0.0f;
+    bool bypass = false;
+    int fuzzQuality = 0;
+    float modRate = 0.0f;
+    float modDepth = 0.0f;
+    int reverbEngine = 0;
+    int fdnMixing = 0;
+};
+
+// Looks the APVTS atomics up once, instead of by string every block.
+class ParameterCache
+{
+public:
+    explicit ParameterCache(juce::AudioProcessorValueTreeState& apvts);
+
+    // Reads every parameter. Derived values such as volGain are only
+    // recomputed when their parameter has changed.
+    const ParameterSnapshot& update() noexcept;
+    const ParameterSnapshot& get() const noexcept {return snapshot;}
+
+private:
+    std::atomic<float>& vol;
+    std::atomic<float>& gain;
+    std::atomic<float>& verb;
+    std::atomic<float>& darkLight;
+    std::atomic<float>& bypass;
+    std::atomic<float>& fuzzQuality;
+    std::atomic<float>& modRate;
+    std::atomic<float>& modDepth;
+    std::atomic<float>& reverbEngine;
+    std::atomic<float>& fdnMixing;
+
+    ParameterSnapshot snapshot;
+};
+
+// Linear per-sample ramp towards a control-rate target. advance() writes the
+// values for the next numSamples into a preallocated array, so stages can
+// read them per sample and gains can be applied with vector operations.
+// Each value is worked out from where the ramp started, so they come out the
+// same however the ramp is split across advance() calls.
+class ParameterRamp
+{
+public:
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = 0.02);
+
+    void setCurrentAndTarget(float newValue) noexcept;
+
+    // Starts a new ramp from the current value, only if the target changed.
+    void setTarget(float newTarget) noexcept;
+
+    void advance(int numSamples) noexcept;
+
+    // From the last advance().
+    const float* getValues() const noexcept {return values.get();}
+    bool isRampingInBlock() const noexcept {return rampingInBlock;}
+    float getBlockStart() const noexcept {return blockStart;}
+    float getBlockEnd() const noexcept {return blockEnd;}
+
+    void applyGain(float* samples, int numSamples) const noexcept;
+    void applyGain(double* samples, int numSamples) const noexcept;
+
+    size_t getAllocatedBytes() const noexcept {return (size_t) maxSamples * sizeof(float);}
+
+private:
+    juce::HeapBlock<float> values;
+    int maxSamples = 0;
+    int rampLength = 1;
+
+    float current = 0.0f, target = 0.0f, origin = 0.0f, step = 0.0f;
+    int stepsLeft = 0;
+
+    bool rampingInBlock = false;
+    float blockStart = 0.0f, blockEnd = 0.0f;
+};
@@ -22,7 +22,19 @@ verbMASCHINEAudioProcessorEditor::verbMASCHINEAudioProcessorEditor (verbMASCHINE
                                                        [this] { return verbKnob.getValue(); });
     addAndMakeVisible(*visualiser);
     
-    startTimerHz(30);
+    analyzer = std::make_unique<AnalyzerComponent>(audioProcessor.analyzerFeed);
+    addChildComponent(*analyzer);
+    
+   #if VERBMASCHINE_STAGE_TIMING
+    stageTimingOverlay = std::make_unique<StageTimingOverlay>(audioProcessor.stageProfiler);
+    addChildComponent(*stageTimingOverlay);
+   #endif
+    
+    // paint() covers every pixel with the cached background.
+    setOpaque(true);
+    
+    // Whatever queued up while no editor was open is stale.
+    audioProcessor.telemetryFeed.discardAll();
     
     setSize(650, 700);
 
@@ -77,6 +89,9 @@ verbMASCHINEAudioProcessorEditor::verbMASCHINEAudioProcessorEditor (verbMASCHINE
     tailsLabel.setText("TAILS", juce::dontSendNotification);
     tailsLabel.setJustificationType(juce::Justification::topLeft);
     tailsLabel.setColour(juce::Label::textColourId, CustomColours::lightGrey);
+    tailsLabel.setInterceptsMouseClicks(true, false);
+    tailsLabel.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    tailsLabel.addMouseListener(this, true);
     
     volAttachment = std::make_unique<SliderAttachment>(audioProcessor.apvts, "VOL", volKnob);
     gainAttachment = std::make_unique<SliderAttachment>(audioProcessor.apvts, "GAIN", gainKnob);
@@ -94,6 +109,24 @@ verbMASCHINEAudioProcessorEditor::~verbMASCHINEAudioProcessorEditor()
 
 //==============================================================================
 void verbMASCHINEAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int cacheWidth = juce::jmax(1, juce::roundToInt(getWidth() * scale));
+    const int cacheHeight = juce::jmax(1, juce::roundToInt(getHeight() * scale));
+    
+    if(backgroundCache.getWidth() != cacheWidth || backgroundCache.getHeight() != cacheHeight)
+    {
+        backgroundCache = juce::Image(juce::Image::RGB, cacheWidth, cacheHeight, false);
+        
+        juce::Graphics cacheGraphics(backgroundCache);
+        cacheGraphics.addTransform(juce::AffineTransform::scale(scale));
+        paintBackground(cacheGraphics);
+    }
+    
+    g.drawImage(backgroundCache, getLocalBounds().toFloat());
+}
+
+void verbMASCHINEAudioProcessorEditor::paintBackground (juce::Graphics& g)
 {
     // Background
     g.fillAll(CustomColours::offBlack);
@@ -113,6 +146,8 @@ void verbMASCHINEAudioProcessorEditor::paint (juce::Graphics& g)
 
 void verbMASCHINEAudioProcessorEditor::resized()
 {
+    backgroundCache = {};
+    
     // Main split into 4 rows
     auto bounds = getLocalBounds().reduced(15);
     const int totalRows = 4;
@@ -180,6 +215,11 @@ void verbMASCHINEAudioProcessorEditor::resized()
     {
         auto visualArea = row2.removeFromLeft(row2.getWidth() * 2 / 3);
         visualiser->setBounds(visualArea);
+        analyzer->setBounds(visualArea);
+        
+       #if VERBMASCHINE_STAGE_TIMING
+        stageTimingOverlay->setBounds(visualArea);
+       #endif
         
         auto darkLightArea = row2.reduced(10);
 
@@ -236,25 +276,57 @@ void verbMASCHINEAudioProcessorEditor::layoutKnobWithLabel(juce::Slider& knob,
     label.setBounds(area.removeFromTop(labelHeight));
 }
 
-void verbMASCHINEAudioProcessorEditor::timerCallback()
+void verbMASCHINEAudioProcessorEditor::advanceFrame()
 {
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    
+    // Frames stop while the window is hidden; don't jump on the first one back.
+    const float seconds = lastFrameTime > 0.0 ? static_cast<float>(juce::jmin(0.1, now - lastFrameTime)) : 0.0f;
+    lastFrameTime = now;
+    
+
     // Meter Updates
-    stereoInputMeter.setRawLevels(
-                               audioProcessor.inputLevelL.load(),
-                               audioProcessor.inputLevelR.load());
-    stereoOutputMeter.setRawLevels(
-                               audioProcessor.outputLevelL.load(),
-                               audioProcessor.outputLevelR.load());
+    // Every block since the last tick is drained, so the meters show the
+    // loudest of them rather than whichever happened to be last.
+    TelemetryRecord record;
+    float inputLevels[2] {}, outputLevels[2] {}, tailLevels[2] {};
+    bool anyRecords = false;
     
-    tailMeter.setRawTailLevels(audioProcessor.tailLevelL.load(),
-                               audioProcessor.tailLevelR.load());
+    while(audioProcessor.telemetryFeed.pop(record))
+    {
+        for(int channel = 0; channel < 2; ++channel)
+        {
+            inputLevels[channel] = juce::jmax(inputLevels[channel], record.inputRms[channel]);
+            outputLevels[channel] = juce::jmax(outputLevels[channel], record.outputRms[channel]);
+            tailLevels[channel] = record.tailLevel[channel];
+        }
+        
+        anyRecords = true;
+    }
+    
+    if(anyRecords)
+    {
+        stereoInputMeter.setRawLevels(inputLevels[0], inputLevels[1]);
+        stereoOutputMeter.setRawLevels(outputLevels[0], outputLevels[1]);
+        tailMeter.setRawTailLevels(tailLevels[0], tailLevels[1]);
+    }
+    
+    stereoInputMeter.advance(seconds);
+    stereoOutputMeter.advance(seconds);
+    tailMeter.advance(seconds);
+    visualiser->advance();
+    analyzer->advance(audioProcessor.getSampleRate(), seconds);
+    
+   #if VERBMASCHINE_STAGE_TIMING
+    stageTimingOverlay->advance(seconds);
+   #endif
     
     // Text Animation
     if (!isAnimating)
         return;
 
-    constexpr float step = 0.1f; // Animation speed
-    colourBlend += step;
+    constexpr float step = 6.0f; // Animation speed, per second
+    colourBlend += step * seconds;
 
     if (colourBlend >= 1.0f)
     {
@@ -268,6 +340,22 @@ void verbMASCHINEAudioProcessorEditor::timerCallback()
 
 void verbMASCHINEAudioProcessorEditor::mouseUp(const juce::MouseEvent& event)
 {
+    if (event.eventComponent == &tailsLabel)
+    {
+        const bool showAnalyzer = ! analyzer->isVisible();
+        analyzer->setVisible(showAnalyzer);
+        visualiser->setVisible(! showAnalyzer);
+        return;
+    }
+    
+   #if VERBMASCHINE_STAGE_TIMING
+    if (event.eventComponent == &titleLabel && event.mods.isAltDown())
+    {
+        stageTimingOverlay->setVisible(! stageTimingOverlay->isVisible());
+        return;
+    }
+   #endif
+    
     if (event.eventComponent == &titleLabel)
     {
         auto& processor = static_cast<verbMASCHINEAudioProcessor&>(audioProcessor);
@@ -285,8 +373,6 @@ void verbMASCHINEAudioProcessorEditor::mouseUp(const juce::MouseEvent& event)
             targetColour = newState ? CustomColours::lightGrey : CustomColours::aqua;
             colourBlend = 0.0f;
             isAnimating = true;
-
-            startTimerHz(60);
         }
     }
 }
@@ -13,6 +13,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "CustomKnob.h"
+#include "TailAnalyzer.h"
 #include "BinaryData.h"
 
 namespace CustomColours
@@ -60,6 +61,55 @@ public:
         auto center = bounds.getCentre();
         auto angle = rotaryStart + sliderPos * (rotaryEnd - rotaryStart);
         
+        // The body and end labels don't move with the value, so a CustomKnob
+        // keeps them as an image at the display's pixel scale and only the
+        // pointer is drawn each time.
+        if(auto* knob = dynamic_cast<struct CustomKnob*>(&slider))
+        {
+            const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+            auto& cache = knob->getBodyCache();
+            const int cacheWidth = juce::jmax(1, juce::roundToInt(slider.getWidth() * scale));
+            const int cacheHeight = juce::jmax(1, juce::roundToInt(slider.getHeight() * scale));
+            
+            if(cache.getWidth() != cacheWidth || cache.getHeight() != cacheHeight)
+            {
+                cache = juce::Image(juce::Image::ARGB, cacheWidth, cacheHeight, true);
+                
+                juce::Graphics cacheGraphics(cache);
+                cacheGraphics.addTransform(juce::AffineTransform::scale(scale));
+                drawKnobBody(cacheGraphics, bounds, rotaryStart, rotaryEnd, knob);
+            }
+            
+            g.drawImage(cache, slider.getLocalBounds().toFloat());
+        }
+        else
+        {
+            drawKnobBody(g, bounds, rotaryStart, rotaryEnd, nullptr);
+        }
+        
+        // Pointer
+        juce::Path pointer;
+        float lineWidth = radius * 0.06f;
+        float pointerLength = radius * 0.5f;
+        float pointerThickness = lineWidth;
+        
+        pointer.addRectangle(-pointerThickness * 0.5f, -(radius),
+                             pointerThickness, pointerLength);
+        
+        g.setColour(CustomColours::darkGrey);
+        g.fillPath(pointer, juce::AffineTransform::rotation(angle).translated(center.x, center.y));
+    }
+    
+private:
+    void drawKnobBody(juce::Graphics& g,
+                      juce::Rectangle<float> bounds,
+                      float rotaryStart,
+                      float rotaryEnd,
+                      struct CustomKnob* knob)
+    {
+        auto radius = bounds.getWidth() * 0.5f;
+        auto center = bounds.getCentre();
+        
         auto cx = center.x;
         auto cy = center.y;
         auto ex = center.x + radius * 1.5f;
@@ -92,18 +142,7 @@ public:
         g.setColour(CustomColours::darkGrey);
         g.drawEllipse(innerBounds, lineWidth);
         
-        // Pointer
-        juce::Path pointer;
-        float pointerLength = radius * 0.5f;
-        float pointerThickness = lineWidth;
-        
-        pointer.addRectangle(-pointerThickness * 0.5f, -(radius),
-                             pointerThickness, pointerLength);
-        
-        g.setColour(CustomColours::darkGrey);
-        g.fillPath(pointer, juce::AffineTransform::rotation(angle).translated(center.x, center.y));
-        
-        if(auto* knob = dynamic_cast<struct CustomKnob*>(&slider))
+        if(knob != nullptr)
         {
             auto leftLabel = knob->getDisplayMin();
             auto rightLabel = knob->getDisplayMax();
@@ -129,49 +168,51 @@ public:
     }
 };
 
-class VisualiserComponent : public juce::Component, private juce::Timer
+// The meter ballistics are per frame factors tuned at 30 frames a second.
+// This gives the factor for a frame of any length, so they look the same at
+// whatever rate the display refreshes.
+inline float smoothingFor(float factorAt30Hz, float seconds)
+{
+    return 1.0f - std::pow(1.0f - factorAt30Hz, seconds * 30.0f);
+}
+
+class VisualiserComponent : public juce::Component
 {
 public:
     VisualiserComponent(std::function<float()> getGainFn, std::function<float()> getVerbFn)
         : getGain(std::move(getGainFn)), getVerb(std::move(getVerbFn))
     {
-        startTimerHz(30);
     }
     
-    void paint(juce::Graphics& g) override
+    // Repaints only the area the triangle covered and now covers, and only
+    // once its apex has moved by a pixel or more.
+    void advance()
     {
-        float padLeft = 50.0f;
-        float padRight = 5.0f;
-
-        auto localBounds = getLocalBounds().toFloat();
-        auto bounds = juce::Rectangle<float>(localBounds.getX() + padLeft,
-                                             localBounds.getY(),
-                                             localBounds.getWidth() - (padLeft + padRight),
-                                             localBounds.getHeight());
-        
-        float gain = juce::jlimit(0.0f, 1.0f, getGain());
-        float verb = juce::jlimit(0.0f, 1.0f, getVerb());
-
-        float baseWidth = bounds.getWidth();
-        float maxHeight = bounds.getHeight() * 0.65f;
-        float fillHeight = gain * maxHeight;
-
-        float centerX = bounds.getCentreX();
-        float baseLeft = centerX - baseWidth * 0.5f;
-        float baseRight = centerX + baseWidth * 0.5f;
+        const auto shape = getShape(getGain(), getVerb());
         
-        float baseY = bounds.getBottom() - 45.0f;
-        float topY = baseY - maxHeight;
-        float currentTopY = baseY - fillHeight;
+        if(std::abs(shape.topX - paintedShape.topX) < 1.0f
+           && std::abs(shape.currentTopY - paintedShape.currentTopY) < 1.0f)
+            return;
         
-        float topX = juce::jmap(verb, centerX, baseRight);
+        repaint(shape.getBounds().getUnion(paintedShape.getBounds()).expanded(3.0f).getSmallestIntegerContainer());
+        paintedShape = shape;
+    }
+    
+    void resized() override
+    {
+        paintedShape = getShape(getGain(), getVerb());
+    }
+    
+    void paint(juce::Graphics& g) override
+    {
+        const auto shape = getShape(getGain(), getVerb());
         
-        if(gain > 0.0f)
+        if(shape.gain > 0.0f)
         {
             juce::Path fillTriangle;
-            fillTriangle.startNewSubPath(topX, currentTopY);
-            fillTriangle.lineTo(baseLeft, baseY);
-            fillTriangle.lineTo(baseRight, baseY);
+            fillTriangle.startNewSubPath(shape.topX, shape.currentTopY);
+            fillTriangle.lineTo(shape.baseLeft, shape.baseY);
+            fillTriangle.lineTo(shape.baseRight, shape.baseY);
             fillTriangle.closeSubPath();
             
             g.setColour(CustomColours::lightGrey);
@@ -179,9 +220,9 @@ public:
         }
 
         juce::Path outlineTriangle;
-        outlineTriangle.startNewSubPath(topX, topY);
-        outlineTriangle.lineTo(baseLeft, baseY);
-        outlineTriangle.lineTo(baseRight, baseY);
+        outlineTriangle.startNewSubPath(shape.topX, shape.topY);
+        outlineTriangle.lineTo(shape.baseLeft, shape.baseY);
+        outlineTriangle.lineTo(shape.baseRight, shape.baseY);
         outlineTriangle.closeSubPath();
 
         g.setColour(CustomColours::lightGrey);
@@ -189,16 +230,56 @@ public:
     }
     
 private:
+    struct Shape
+    {
+        float gain = 0.0f;
+        float baseLeft = 0.0f, baseRight = 0.0f, baseY = 0.0f;
+        float topX = 0.0f, topY = 0.0f, currentTopY = 0.0f;
+        
+        juce::Rectangle<float> getBounds() const
+        {
+            return juce::Rectangle<float>::leftTopRightBottom(juce::jmin(baseLeft, topX), topY,
+                                                              juce::jmax(baseRight, topX), baseY);
+        }
+    };
+    
     std::function<float()> getGain;
     std::function<float()> getVerb;
+    Shape paintedShape;
     
-    void timerCallback() override
+    Shape getShape(float gainValue, float verbValue) const
     {
-        repaint();
+        float padLeft = 50.0f;
+        float padRight = 5.0f;
+
+        auto localBounds = getLocalBounds().toFloat();
+        auto bounds = juce::Rectangle<float>(localBounds.getX() + padLeft,
+                                             localBounds.getY(),
+                                             localBounds.getWidth() - (padLeft + padRight),
+                                             localBounds.getHeight());
+        
+        Shape shape;
+        shape.gain = juce::jlimit(0.0f, 1.0f, gainValue);
+        float verb = juce::jlimit(0.0f, 1.0f, verbValue);
+
+        float baseWidth = bounds.getWidth();
+        float maxHeight = bounds.getHeight() * 0.65f;
+        float fillHeight = shape.gain * maxHeight;
+
+        float centerX = bounds.getCentreX();
+        shape.baseLeft = centerX - baseWidth * 0.5f;
+        shape.baseRight = centerX + baseWidth * 0.5f;
+        
+        shape.baseY = bounds.getBottom() - 45.0f;
+        shape.topY = shape.baseY - maxHeight;
+        shape.currentTopY = shape.baseY - fillHeight;
+        
+        shape.topX = juce::jmap(verb, centerX, shape.baseRight);
+        return shape;
     }
 };
 
-class StereoMeterComponent : public juce::Component, private juce::Timer
+class StereoMeterComponent : public juce::Component
 {
 public:
     StereoMeterComponent()
@@ -217,7 +298,8 @@ public:
         setupLabel(leftLevelLabel);
         setupLabel(rightLevelLabel);
         
-        startTimerHz(30);
+        setLevelText(leftLevelLabel, leftShownDecibels, 0.0f);
+        setLevelText(rightLevelLabel, rightShownDecibels, 0.0f);
     }
     
     void setRawLevels(float left, float right)
@@ -227,13 +309,33 @@ public:
         
         if(leftRawLevel >= 0.99f) clipOpacityLeft = 1.0f;
         if(rightRawLevel >= 0.99f) clipOpacityRight = 1.0f;
-        
-        repaint();
     }
     
     void setChannelHeight(float h) {channelHeight = h;}
     void setChannelSpacing(float s) {channelSpacing = s;}
     
+    // Moves the meters on by one display frame and repaints what changed.
+    void advance(float seconds)
+    {
+        const float smoothing = smoothingFor(smoothFactor, seconds);
+        const float textSmoothing = smoothingFor(textSmoothFactor, seconds);
+        
+        leftSmoothedLevel = smoothing * leftRawLevel + (1.0f - smoothing) * leftSmoothedLevel;
+        rightSmoothedLevel = smoothing * rightRawLevel + (1.0f - smoothing) * rightSmoothedLevel;
+        leftTextLevel = textSmoothing * leftRawLevel + (1.0f - textSmoothing) * leftTextLevel;
+        rightTextLevel = textSmoothing * rightRawLevel + (1.0f - textSmoothing) * rightTextLevel;
+        
+        const float fade = clipFade * seconds * 30.0f;
+        clipOpacityLeft = juce::jmax(0.0f, clipOpacityLeft - fade);
+        clipOpacityRight = juce::jmax(0.0f, clipOpacityRight - fade);
+        
+        setLevelText(leftLevelLabel, leftShownDecibels, leftTextLevel);
+        setLevelText(rightLevelLabel, rightShownDecibels, rightTextLevel);
+        
+        repaintChanges(leftMeterBounds, leftSmoothedLevel, clipOpacityLeft, leftPainted);
+        repaintChanges(rightMeterBounds, rightSmoothedLevel, clipOpacityRight, rightPainted);
+    }
+    
     void resized() override
     {
         auto r = getLocalBounds().toFloat();
@@ -260,9 +362,22 @@ public:
         
         leftLevelLabel.setBounds(leftTextArea.toNearestInt());
         rightLevelLabel.setBounds(rightTextArea.toNearestInt());
+        
+        leftGradient = juce::ColourGradient::horizontal(CustomColours::darkGreen, CustomColours::green, leftMeterBounds);
+        rightGradient = juce::ColourGradient::horizontal(CustomColours::darkGreen, CustomColours::green, rightMeterBounds);
+        
+        leftPainted = getPaintedState(leftMeterBounds, leftSmoothedLevel, clipOpacityLeft);
+        rightPainted = getPaintedState(rightMeterBounds, rightSmoothedLevel, clipOpacityRight);
     }
     
 private:
+    // What the last repaint of one meter showed, in pixels.
+    struct PaintedState
+    {
+        float fillWidth = 0.0f;
+        float clipWidth = 0.0f;
+    };
+    
     float leftRawLevel = 0.0f, rightRawLevel = 0.0f;
     float leftSmoothedLevel = 0.0f, rightSmoothedLevel = 0.0f;
     float leftTextLevel = 0.0f, rightTextLevel = 0.0f;
@@ -277,45 +392,69 @@ private:
 
     juce::Rectangle<float> leftMeterBounds, rightMeterBounds;
     juce::Rectangle<float> leftTextArea, rightTextArea;
+    juce::ColourGradient leftGradient, rightGradient;
+    PaintedState leftPainted, rightPainted;
     
     juce::Label leftLevelLabel, rightLevelLabel;
+    float leftShownDecibels = 1.0f, rightShownDecibels = 1.0f;
     
-    void timerCallback() override
+    // The labels show tenths of a dB, so they only change when that does.
+    static void setLevelText(juce::Label& label, float& shownDecibels, float level)
     {
-        leftSmoothedLevel = smoothFactor * leftRawLevel + (1.0f - smoothFactor) * leftSmoothedLevel;
-        rightSmoothedLevel = smoothFactor * rightRawLevel + (1.0f - smoothFactor) * rightSmoothedLevel;
-        leftTextLevel = textSmoothFactor * leftRawLevel + (1.0f - textSmoothFactor) * leftTextLevel;
-        rightTextLevel = textSmoothFactor * rightRawLevel + (1.0f - textSmoothFactor) * rightTextLevel;
+        const float decibels = level <= 0.0001f ? -std::numeric_limits<float>::infinity()
+                                                : std::round(juce::Decibels::gainToDecibels(level, -80.0f) * 10.0f) / 10.0f;
         
-        if(clipOpacityLeft > 0.0f)
-            clipOpacityLeft = juce::jmax(0.0f, clipOpacityLeft - clipFade);
-        if(clipOpacityRight > 0.0f)
-            clipOpacityRight = juce::jmax(0.0f, clipOpacityRight - clipFade);
+        if(decibels == shownDecibels)
+            return;
         
-        auto toDbString = [](float level)
-        {
-            if (level <= 0.0001f)
-                return juce::String::fromUTF8 (u8"-\u221E"); // '-∞'
-            else
-                return juce::String(juce::Decibels::gainToDecibels(level, -80.0f), 1);
-        };
+        shownDecibels = decibels;
+        label.setText(std::isinf(decibels) ? juce::String::fromUTF8 (u8"-\u221E") // '-∞'
+                                           : juce::String(decibels, 1),
+                      juce::dontSendNotification);
+    }
+    
+    static PaintedState getPaintedState(juce::Rectangle<float> area, float level, float clipOpacity)
+    {
+        PaintedState state;
+        state.fillWidth = area.getWidth() * std::pow(level, 0.33f);
+        state.clipWidth = clipOpacity > 0.0f ? juce::jlimit(0.0f, area.getWidth(), level * 20.0f) : 0.0f;
+        return state;
+    }
+    
+    // Invalidates the strip between the old and new fill edge, and the clip
+    // marker, once either has moved by a pixel.
+    void repaintChanges(juce::Rectangle<float> area, float level, float clipOpacity, PaintedState& painted)
+    {
+        const auto state = getPaintedState(area, level, clipOpacity);
         
-        leftLevelLabel.setText(toDbString(leftTextLevel), juce::dontSendNotification);
-        rightLevelLabel.setText(toDbString(rightTextLevel), juce::dontSendNotification);
+        if(std::abs(state.fillWidth - painted.fillWidth) >= 1.0f)
+        {
+            const float from = juce::jmin(state.fillWidth, painted.fillWidth);
+            const float to = juce::jmax(state.fillWidth, painted.fillWidth);
+            repaint(area.withTrimmedLeft(from).withWidth(to - from).getSmallestIntegerContainer());
+            painted.fillWidth = state.fillWidth;
+        }
         
-        repaint();
+        if(std::abs(state.clipWidth - painted.clipWidth) >= 1.0f
+           || (state.clipWidth == 0.0f) != (painted.clipWidth == 0.0f))
+        {
+            const float clipWidth = juce::jmax(state.clipWidth, painted.clipWidth);
+            repaint(area.withTrimmedLeft(area.getWidth() - clipWidth).getSmallestIntegerContainer());
+            painted.clipWidth = state.clipWidth;
+        }
     }
     
     void paint(juce::Graphics& g) override
     {
-        drawOneMeter(g, leftMeterBounds, leftSmoothedLevel, clipOpacityLeft);
-        drawOneMeter(g, rightMeterBounds, rightSmoothedLevel, clipOpacityRight);
+        drawOneMeter(g, leftMeterBounds, leftGradient, leftSmoothedLevel, clipOpacityLeft);
+        drawOneMeter(g, rightMeterBounds, rightGradient, rightSmoothedLevel, clipOpacityRight);
     }
     
     void drawOneMeter(juce::Graphics& g,
                       juce::Rectangle<float> area,
+                      const juce::ColourGradient& gradient,
                       float level,
-                      float& clipOpacity)
+                      float clipOpacity)
     {
         g.setColour(CustomColours::lightGrey);
         g.fillRect(area);
@@ -323,9 +462,7 @@ private:
         const float shapedLevel = std::pow(level, 0.33f);
         const float fillWidth = area.getWidth() * shapedLevel;
         
-        auto greenGradient = juce::ColourGradient::horizontal(CustomColours::darkGreen, CustomColours::green, area);
-
-        g.setGradientFill(greenGradient);
+        g.setGradientFill(gradient);
         g.fillRect(area.withWidth(fillWidth));
         
         if(clipOpacity > 0.0f)
@@ -337,14 +474,9 @@ private:
     }
 };
 
-class TailMeterComponent : public juce::Component, private juce::Timer
+class TailMeterComponent : public juce::Component
 {
 public:
-    TailMeterComponent()
-    {
-        startTimerHz(30);
-    }
-    
     void setRawTailLevels(float left, float right)
     {
         rawL = left;
@@ -355,13 +487,57 @@ public:
         smoothedL = smoothedR = 0.0f;
     }
     
+    // Moves the meter on by one display frame and repaints the strip between
+    // the old and new fill edge, once that has moved by a pixel.
+    void advance(float seconds)
+    {
+        const float smoothing = smoothingFor(smoothAlpha, seconds);
+        smoothedL = smoothing * rawL + (1.0f - smoothing) * smoothedL;
+        smoothedR = smoothing * rawR + (1.0f - smoothing) * smoothedR;
+        
+        const auto area = getMeterArea();
+        const float fillWidth = getFillWidth(area);
+        
+        if(std::abs(fillWidth - paintedFillWidth) < 1.0f)
+            return;
+        
+        const float from = juce::jmin(fillWidth, paintedFillWidth);
+        const float to = juce::jmax(fillWidth, paintedFillWidth);
+        repaint(area.withTrimmedLeft(from).withWidth(to - from).getSmallestIntegerContainer());
+        paintedFillWidth = fillWidth;
+    }
+    
+    void resized() override
+    {
+        aquaGradient = juce::ColourGradient::horizontal(CustomColours::blue, CustomColours::aqua, getMeterArea());
+        paintedFillWidth = getFillWidth(getMeterArea());
+    }
+    
     void paint(juce::Graphics& g) override
     {
-        auto area = getLocalBounds().toFloat().reduced(4.0f);
+        auto area = getMeterArea();
         
         g.setColour(CustomColours::lightGrey);
         g.fillRect(area);
         
+        g.setGradientFill(aquaGradient);
+        g.fillRect(area.removeFromLeft(getFillWidth(area)));
+    }
+    
+private:
+    float rawL = 0.0f, rawR = 0.0f;
+    float smoothedL = 0.0f, smoothedR = 0.0f;
+    const float smoothAlpha = 0.2f;
+    float paintedFillWidth = 0.0f;
+    juce::ColourGradient aquaGradient;
+    
+    juce::Rectangle<float> getMeterArea() const
+    {
+        return getLocalBounds().toFloat().reduced(4.0f);
+    }
+    
+    float getFillWidth(juce::Rectangle<float> area) const
+    {
         float level = juce::jmax(smoothedL, smoothedR);
         
         auto decayShape = [](float x)
@@ -370,29 +546,248 @@ public:
         };
         
         float fillRatio = juce::jlimit(0.0f, 1.0f, decayShape(level));
-        float fillWidth = area.getWidth() * fillRatio;
-        
-        auto aquaGradient = juce::ColourGradient::horizontal(CustomColours::blue, CustomColours::aqua, area);
+        return area.getWidth() * fillRatio;
+    }
+};
 
-        g.setGradientFill(aquaGradient);
-        g.fillRect(area.removeFromLeft(fillWidth));
+// Spectrum and scrolling waveform of the dry, fuzzed and wet signals, in
+// place of the visualiser while TAILS is toggled on. The processor only
+// copies audio for it while it is visible.
+class AnalyzerComponent : public juce::Component
+{
+public:
+    explicit AnalyzerComponent(AnalyzerFeed& feedToShow)
+        : feed(feedToShow), analyzer(feedToShow)
+    {
+    }
+    
+    ~AnalyzerComponent() override
+    {
+        feed.setActive(false);
+    }
+    
+    void visibilityChanged() override
+    {
+        analyzer.reset();
+        feed.setActive(isVisible());
+    }
+    
+    void advance(double sampleRate, float seconds)
+    {
+        if(isVisible() && analyzer.update(sampleRate, seconds))
+            repaint(contentArea.getSmallestIntegerContainer());
+    }
+    
+    void resized() override
+    {
+        auto area = getLocalBounds().toFloat().reduced(4.0f);
+        background = area;
+        
+        contentArea = area.reduced(10.0f, 8.0f);
+        auto content = contentArea;
+        spectrumArea = content.removeFromTop(content.getHeight() * 0.65f);
+        content.removeFromTop(6.0f);
+        waveformArea = content;
+    }
+    
+    void paint(juce::Graphics& g) override
+    {
+        g.setColour(CustomColours::darkGrey);
+        g.fillRoundedRectangle(background, 10.0f);
+        
+        for(int stream = 0; stream < AnalyzerFeed::numStreams; ++stream)
+        {
+            const auto id = static_cast<AnalyzerFeed::Stream>(stream);
+            paintSpectrum(g, id, getStreamColour(id));
+            paintWaveform(g, id, getStreamColour(id));
+        }
+        
+        g.setFont(juce::Font(CustomFonts::karasumaGothicBold.withHeight(11.0f)));
+        
+        const char* const names[] {"DRY", "FUZZ", "WET"};
+        auto legend = spectrumArea.withHeight(12.0f);
+        
+        for(int stream = 0; stream < AnalyzerFeed::numStreams; ++stream)
+        {
+            g.setColour(getStreamColour(static_cast<AnalyzerFeed::Stream>(stream)));
+            g.drawText(names[stream], legend.removeFromLeft(36.0f), juce::Justification::centredLeft);
+        }
     }
     
 private:
-    float rawL = 0.0f, rawR = 0.0f;
-    float smoothedL = 0.0f, smoothedR = 0.0f;
-    const float smoothAlpha = 0.2f;
+    AnalyzerFeed& feed;
+    TailAnalyzer analyzer;
+    
+    juce::Rectangle<float> background, contentArea, spectrumArea, waveformArea;
+    
+    static juce::Colour getStreamColour(AnalyzerFeed::Stream stream)
+    {
+        switch(stream)
+        {
+            case AnalyzerFeed::dry:    return CustomColours::lightGrey;
+            case AnalyzerFeed::fuzzed: return CustomColours::green;
+            default:                   return CustomColours::aqua;
+        }
+    }
+    
+    float decibelsToY(float decibels) const
+    {
+        return juce::jmap(juce::jlimit(TailAnalyzer::floorDecibels, 0.0f, decibels),
+                          TailAnalyzer::floorDecibels, 0.0f,
+                          spectrumArea.getBottom(), spectrumArea.getY());
+    }
     
-    void timerCallback() override
+    void paintSpectrum(juce::Graphics& g, AnalyzerFeed::Stream stream, juce::Colour colour)
     {
-        smoothedL = smoothAlpha * rawL + (1.0f - smoothAlpha) * smoothedL;
-        smoothedR = smoothAlpha * rawR + (1.0f - smoothAlpha) * smoothedR;
+        const float* spectrum = analyzer.getSpectrum(stream);
+        const float* peaks = analyzer.getPeaks(stream);
+        const float bandWidth = spectrumArea.getWidth() / TailAnalyzer::numBands;
+        
+        juce::Path line;
+        
+        for(int band = 0; band < TailAnalyzer::numBands; ++band)
+        {
+            const float x = spectrumArea.getX() + (band + 0.5f) * bandWidth;
+            
+            if(band == 0)
+                line.startNewSubPath(x, decibelsToY(spectrum[band]));
+            else
+                line.lineTo(x, decibelsToY(spectrum[band]));
+        }
+        
+        g.setColour(colour);
+        g.strokePath(line, juce::PathStrokeType(1.5f));
+        
+        g.setColour(colour.withAlpha(0.6f));
+        
+        for(int band = 0; band < TailAnalyzer::numBands; ++band)
+        {
+            if(peaks[band] > TailAnalyzer::floorDecibels)
+                g.fillRect(spectrumArea.getX() + band * bandWidth, decibelsToY(peaks[band]) - 1.0f, bandWidth, 1.5f);
+        }
+    }
+    
+    void paintWaveform(juce::Graphics& g, AnalyzerFeed::Stream stream, juce::Colour colour)
+    {
+        const float columnWidth = waveformArea.getWidth() / TailAnalyzer::numColumns;
+        const float centreY = waveformArea.getCentreY();
+        const float halfHeight = waveformArea.getHeight() * 0.5f;
+        
+        g.setColour(colour.withAlpha(0.5f));
+        
+        for(int column = 0; column < TailAnalyzer::numColumns; ++column)
+        {
+            const float top = centreY - juce::jlimit(-1.0f, 1.0f, analyzer.getColumnMax(stream, column)) * halfHeight;
+            const float bottom = centreY - juce::jlimit(-1.0f, 1.0f, analyzer.getColumnMin(stream, column)) * halfHeight;
+            
+            g.fillRect(waveformArea.getX() + column * columnWidth, top, columnWidth, juce::jmax(1.0f, bottom - top));
+        }
+    }
+};
+
+#if VERBMASCHINE_STAGE_TIMING
+// Debug overlay with the cost of each processBlock stage. Hidden until the
+// title is alt-clicked. Clicking it saves the histograms as CSV and JSON,
+// shift-clicking starts them over.
+class StageTimingOverlay : public juce::Component
+{
+public:
+    explicit StageTimingOverlay(StageProfiler& profilerToShow)
+        : profiler(profilerToShow)
+    {
+        setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    }
+    
+    void advance(float seconds)
+    {
+        // A few times a second is plenty to read numbers by.
+        sinceRefresh += seconds;
+        
+        if(! isVisible() || sinceRefresh < 0.25f)
+            return;
+        
+        sinceRefresh = 0.0f;
+        
+        for(int stage = 0; stage < StageProfiler::numStages; ++stage)
+            summaries[stage] = profiler.getSummary(static_cast<StageProfiler::Stage>(stage));
+        
         repaint();
     }
+    
+    void paint(juce::Graphics& g) override
+    {
+        g.fillAll(juce::Colours::black.withAlpha(0.85f));
+        g.setFont(juce::Font(juce::FontOptions(juce::Font::getDefaultMonospacedFontName(), 12.0f, juce::Font::plain)));
+        g.setColour(CustomColours::lightGrey);
+        
+        auto area = getLocalBounds().reduced(10);
+        const int lineHeight = 16;
+        
+        auto row = [&](const juce::String& name, const juce::String& calls, const juce::String& mean,
+                       const juce::String& p99, const juce::String& max)
+        {
+            auto line = area.removeFromTop(lineHeight);
+            const int column = line.getWidth() / 6;
+            g.drawText(name, line.removeFromLeft(column * 2), juce::Justification::centredLeft);
+            g.drawText(calls, line.removeFromLeft(column), juce::Justification::centredRight);
+            g.drawText(mean, line.removeFromLeft(column), juce::Justification::centredRight);
+            g.drawText(p99, line.removeFromLeft(column), juce::Justification::centredRight);
+            g.drawText(max, line, juce::Justification::centredRight);
+        };
+        
+        row(juce::String("stage (") + StageProfiler::getTickUnit() + ")", "calls", "mean", "p99", "max");
+        
+        for(int stage = 0; stage < StageProfiler::numStages; ++stage)
+        {
+            const auto& summary = summaries[stage];
+            row(StageProfiler::getStageName(stage), juce::String((juce::int64) summary.calls),
+                juce::String(summary.getMeanTicks(), 0), juce::String((juce::int64) summary.p99Ticks),
+                juce::String((juce::int64) summary.maxTicks));
+        }
+        
+        area.removeFromTop(lineHeight / 2);
+        g.drawFittedText(status, area, juce::Justification::topLeft, 3);
+    }
+    
+    void mouseUp(const juce::MouseEvent& event) override
+    {
+        if(event.mods.isShiftDown())
+        {
+            profiler.reset();
+            status = "Reset";
+        }
+        else
+        {
+            status = save();
+        }
+        
+        sinceRefresh = 1.0f;
+        repaint();
+    }
+    
+private:
+    StageProfiler& profiler;
+    StageProfiler::Summary summaries[StageProfiler::numStages];
+    float sinceRefresh = 0.0f;
+    juce::String status {"Click to save CSV and JSON, shift-click to reset"};
+    
+    juce::String save() const
+    {
+        auto folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                          .getChildFile("verbMASCHINE Stage Timing");
+        const auto name = "stages-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S");
+        
+        if(! folder.createDirectory()
+           || ! folder.getChildFile(name + ".csv").replaceWithText(profiler.toCsv())
+           || ! folder.getChildFile(name + ".json").replaceWithText(juce::JSON::toString(profiler.toJson())))
+            return "Couldn't save to " + folder.getFullPathName();
+        
+        return "Saved " + name + ".csv and .json to " + folder.getFullPathName();
+    }
 };
+#endif
 
-class verbMASCHINEAudioProcessorEditor  :   public juce::AudioProcessorEditor,
-                                                    private juce::Timer
+class verbMASCHINEAudioProcessorEditor  :   public juce::AudioProcessorEditor
 {
 public:
     verbMASCHINEAudioProcessorEditor (verbMASCHINEAudioProcessor&);
@@ -403,7 +798,6 @@ public:
     void resized() override;
     void layoutKnobWithLabel(juce::Slider&, juce::Label&, const juce::String&, juce::Rectangle<int>);
     void mouseUp(const juce::MouseEvent& event) override;
-    void timerCallback() override;
 
 private:
     verbMASCHINEAudioProcessor& audioProcessor;
@@ -414,9 +808,19 @@ private:
     juce::Label titleLabel, volLabel, gainLabel, verbLabel, darkLightLabel;
     
     std::unique_ptr<VisualiserComponent> visualiser;
+    std::unique_ptr<AnalyzerComponent> analyzer;
+    
+   #if VERBMASCHINE_STAGE_TIMING
+    std::unique_ptr<StageTimingOverlay> stageTimingOverlay;
+   #endif
     
     juce::Rectangle<int> row1Fill;
     juce::Rectangle<int> inputFill, outputFill;
+    
+    // The background, border and meter wells, at the display's pixel scale.
+    // Cleared on resize and redrawn when the scale changes.
+    juce::Image backgroundCache;
+    void paintBackground(juce::Graphics& g);
     juce::Label inputLabel, outputLabel;
     juce::Label tailsLabel;
     
@@ -432,6 +836,14 @@ private:
     juce::Colour targetColour = CustomColours::lightGrey;
     float colourBlend = 0.0f;
     bool isAnimating = false;
+    
+    // Everything that moves is advanced from here, once per display refresh.
+    // Each part repaints only what visibly changed, so an idle editor costs
+    // little more than the callback itself.
+    double lastFrameTime = 0.0;
+    void advanceFrame();
+    
+    juce::VBlankAttachment vBlankAttachment {this, [this] {advanceFrame();}};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (verbMASCHINEAudioProcessorEditor)
 };
@@ -7,7 +7,11 @@
 */
 
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#if ! VERBMASCHINE_HEADLESS
+ #include "PluginEditor.h"
+#endif
+#include "WetStages.h"
+#include "FastMath.h"
 
 juce::AudioProcessorValueTreeState::ParameterLayout verbMASCHINEAudioProcessor::createParameterLayout()
 {
@@ -34,6 +38,21 @@ juce::AudioProcessorValueTreeState::ParameterLayout verbMASCHINEAudioProcessor::
     
     layout.push_back(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("BYPASS", 1), "BYPASS", false));
     
+    layout.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("FUZZ_QUALITY", 1),
+        "FUZZ QUALITY", FuzzStage::getQualityNames(), FuzzStage::off));
+    
+    layout.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("MOD_RATE", 1),
+        "MOD RATE", juce::NormalisableRange<float>(0.05f, 5.0f, 0.01f, 0.5f), 0.6f));
+    
+    layout.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("MOD_DEPTH", 1),
+        "MOD DEPTH", juce::NormalisableRange<float>(0.0f, 1.0f, 0.0001f), 0.6f));
+    
+    layout.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("REVERB_ENGINE", 1),
+        "REVERB ENGINE", ReverbEngine::getEngineNames(), ReverbEngine::freeverb));
+    
+    layout.push_back(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("FDN_MIXING", 1),
+        "FDN MIXING", ReverbEngine::getMixingNames(), static_cast<int>(FdnMixing::hadamard)));
+    
     return {layout.begin(), layout.end()};
 }
 
@@ -48,6 +67,7 @@ verbMASCHINEAudioProcessor::verbMASCHINEAudioProcessor()
 
 verbMASCHINEAudioProcessor::~verbMASCHINEAudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -85,7 +105,47 @@ bool verbMASCHINEAudioProcessor::isMidiEffect() const
 
 double verbMASCHINEAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    return tailLengthSeconds;
+}
+
+double verbMASCHINEAudioProcessor::measureReverbDecaySeconds(double sampleRate, int engine) const
+{
+    // Drives a private copy of the reverb with a full scale noise burst and
+    // times how long its output takes to fall below the silence threshold.
+    constexpr int blockSize = 512;
+    
+    ReverbEngine reverb;
+    reverb.setParameters(reverbParams);
+    reverb.prepare(sampleRate, blockSize);
+    reverb.setEngine(engine, false);
+    
+    std::array<float, blockSize> left, right;
+    juce::Random random(0x5eed);
+    
+    const int burstLength = juce::roundToInt(sampleRate * 0.25);
+    const int maxLength = burstLength + juce::roundToInt(sampleRate * maxTailSeconds);
+    const int quietToStop = juce::roundToInt(sampleRate * 0.5);
+    int lastLoudSample = burstLength;
+    
+    for(int start = 0; start < maxLength && start - lastLoudSample < quietToStop; start += blockSize)
+    {
+        for(int i = 0; i < blockSize; ++i)
+        {
+            const bool inBurst = start + i < burstLength;
+            left[(size_t) i] = inBurst ? random.nextFloat() * 2.0f - 1.0f : 0.0f;
+            right[(size_t) i] = inBurst ? random.nextFloat() * 2.0f - 1.0f : 0.0f;
+        }
+        
+        reverb.process<2>(left.data(), right.data(), blockSize);
+        
+        for(int i = 0; i < blockSize; ++i)
+        {
+            if(std::abs(left[(size_t) i]) >= silenceThreshold || std::abs(right[(size_t) i]) >= silenceThreshold)
+                lastLoudSample = start + i;
+        }
+    }
+    
+    return static_cast<double>(lastLoudSample - burstLength) / sampleRate;
 }
 
 int verbMASCHINEAudioProcessor::getNumPrograms()
@@ -115,61 +175,147 @@ void verbMASCHINEAudioProcessor::changeProgramName (int index, const juce::Strin
 //==============================================================================
 void verbMASCHINEAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    // Nothing runs on more than one control sub-block at a time, so that is
+    // all the block sized buffers have to hold, whatever the host's block.
+    const int internalBlockSize = juce::jlimit(1, controlBlockSize, samplesPerBlock);
+    
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
+    spec.maximumBlockSize = static_cast<juce::uint32>(internalBlockSize);
     spec.numChannels = getTotalNumOutputChannels();
     
-    reverbL.reset();
-    reverbR.reset();
-    reverbL.setSampleRate(sampleRate);
-    reverbR.setSampleRate(sampleRate);
-    
-    reverbHighCutL.prepare(spec);
-    reverbHighCutR.prepare(spec);
-    reverbHighCutL.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    reverbHighCutR.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    reverbHighCutL.setCutoffFrequency(15000.0f);
-    reverbHighCutR.setCutoffFrequency(15000.0f);
-    reverbHighCutL.setResonance(0.3f);
-    reverbHighCutR.setResonance(0.3f);
-    
-    tailFilterL.prepare(spec);
-    tailFilterR.prepare(spec);
-    tailFilterL.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-    tailFilterR.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-    tailFilterL.setResonance(0.5f);
-    tailFilterR.setResonance(0.5f);
-    
-    tailCutoffL.reset(sampleRate, 0.05);
-    tailCutoffR.reset(sampleRate, 0.05);
-    
-    tailModDelayL.reset();
-    tailModDelayR.reset();
-    tailModDelayL.prepare(spec);
-    tailModDelayR.prepare(spec);
-    tailModDelayL.setMaximumDelayInSamples(static_cast<int>(sampleRate));
-    tailModDelayR.setMaximumDelayInSamples(static_cast<int>(sampleRate));
-    tailModDelayL.setDelay(10.0f);
-    tailModDelayR.setDelay(10.0f);
-    
-    preDelayL.reset();
-    preDelayR.reset();
-    preDelayL.prepare(spec);
-    preDelayR.prepare(spec);
-    preDelayL.setMaximumDelayInSamples(static_cast<int>(sampleRate * 1.0f));
-    preDelayR.setMaximumDelayInSamples(static_cast<int>(sampleRate * 1.0f));
-    preDelayL.setDelay((sampleRate * preDelayTimeMs) / 1000.0f);
-    preDelayR.setDelay((sampleRate * preDelayTimeMs) / 1000.0f);
-    
-    tiltLowShelfL.reset();
-    tiltLowShelfR.reset();
-    tiltHighShelfL.reset();
-    tiltHighShelfR.reset();
-    tiltLowShelfL.prepare(spec);
-    tiltLowShelfR.prepare(spec);
-    tiltHighShelfL.prepare(spec);
-    tiltHighShelfR.prepare(spec);
+    reverbParams.roomSize = 0.95f;
+    reverbParams.damping = 0.1f;
+    reverbParams.wetLevel = 1.0f;
+    reverbParams.dryLevel = 0.0f;
+    reverbParams.width = 0.8f;
+    reverbParams.freezeMode = 0.0f;
+    
+    dsp.reverb.setParameters(reverbParams);
+    dsp.reverb.prepare(sampleRate, internalBlockSize);
+    
+    dsp.wetFilters.prepare(sampleRate);
+    dsp.precisionWetFilters.prepare(sampleRate);
+    
+    const auto& params = parameters.update();
+    
+    dsp.reverb.setMixing(static_cast<FdnMixing>(params.fdnMixing));
+    dsp.reverb.setEngine(params.reverbEngine, false);
+    
+    dsp.wetFilters.tilt.setTilt(params.darkLight, false);
+    dsp.precisionWetFilters.tilt.setTilt(params.darkLight, false);
+    
+    dsp.gainRamp.prepare(sampleRate, internalBlockSize);
+    dsp.verbRamp.prepare(sampleRate, internalBlockSize);
+    dsp.volRamp.prepare(sampleRate, internalBlockSize);
+    dsp.gainRamp.setCurrentAndTarget(params.gain);
+    dsp.verbRamp.setCurrentAndTarget(params.verb);
+    dsp.volRamp.setCurrentAndTarget(params.volGain);
+    
+    dsp.tailCutoffL.reset(sampleRate, 0.05);
+    dsp.tailCutoffR.reset(sampleRate, 0.05);
+    
+    numEngineChannels = getTotalNumOutputChannels() > 1 ? 2 : 1;
+    
+    const bool doublePrecision = isUsingDoublePrecision();
+    dsp.fuzz.prepare(static_cast<int>(spec.numChannels), internalBlockSize, doublePrecision);
+    
+    // Only the precision the host will call with gets any memory.
+    if(doublePrecision)
+    {
+        prepareSampleTypeState<double>(spec);
+        dsp.floatPath = SampleTypeState<float>();
+        scratchBuffers.release();
+        processChunkForLayout = nullptr;
+        processDoubleChunkForLayout = numEngineChannels > 1 ? &verbMASCHINEAudioProcessor::processChunk<2, double>
+                                                            : &verbMASCHINEAudioProcessor::processChunk<1, double>;
+    }
+    else
+    {
+        prepareSampleTypeState<float>(spec);
+        dsp.doublePath = SampleTypeState<double>();
+        doubleScratchBuffers.release();
+        processDoubleChunkForLayout = nullptr;
+        processChunkForLayout = numEngineChannels > 1 ? &verbMASCHINEAudioProcessor::processChunk<2, float>
+                                                      : &verbMASCHINEAudioProcessor::processChunk<1, float>;
+    }
+    
+    // Hosts normally switch to offline rendering before preparing, so the
+    // render mode and its latency are settled here without any crossfade.
+    renderModeActive = isNonRealtime();
+    applyRenderMode();
+    
+    dsp.fuzz.setQuality(getEffectiveFuzzQuality(), false);
+    setBypassDelay(dsp.fuzz.getLatencyInSamples());
+    
+    // Not on the audio thread here, so the host can hear about it at once.
+    cancelPendingUpdate();
+    latencyToReport.store(dsp.fuzz.getLatencyInSamples());
+    setLatencySamples(dsp.fuzz.getLatencyInSamples());
+    
+    // === Tail and Sleep === //
+    // The engine can change at any time, so the longest one is reported.
+    // Measured once per sample rate for the whole process.
+    double reverbDecaySeconds = 0.0;
+    for(int engine = 0; engine < ReverbEngine::numEngines; ++engine)
+    {
+        auto measure = [this, sampleRate, engine] {return measureReverbDecaySeconds(sampleRate, engine);};
+        reverbDecaySeconds = juce::jmax(reverbDecaySeconds, tables->getReverbDecaySeconds(sampleRate, engine, measure));
+    }
+    
+    // Everything that delays the wet signal before or after the reverb.
+    const int pipelineDelay = juce::roundToInt(sampleRate * preDelayTimeMs / 1000.0f)
+                            + static_cast<int>(modCentreDelay + maxModDepth)
+                            + dsp.fuzz.getMaxLatencyInSamples();
+    
+    tailLengthSeconds = reverbDecaySeconds + pipelineDelay / sampleRate;
+    
+    // Signal still travelling through the delays is invisible to the level
+    // checks, so they must stay quiet for longer than it takes to come out.
+    quietSamplesToSleep = pipelineDelay + juce::roundToInt(sampleRate * 0.1);
+    quietSamples = 0;
+    sleeping = false;
+    
+    controlPhase = 0;
+    subBlockQuiet = true;
+}
+
+template <typename SampleType>
+void verbMASCHINEAudioProcessor::prepareSampleTypeState(const juce::dsp::ProcessSpec& spec)
+{
+    auto& path = dsp.path<SampleType>();
+    const double sampleRate = spec.sampleRate;
+    const int samplesPerBlock = static_cast<int>(spec.maximumBlockSize);
+    const auto& params = parameters.get();
+    
+    // The delay lines only get room for the longest delay they can reach,
+    // plus a sample for interpolation.
+    path.tailModulation.setCentreDelay(modCentreDelay);
+    path.tailModulation.setRate(params.modRate);
+    path.tailModulation.setDepth(params.modDepth * maxModDepth);
+    path.tailModulation.prepare(sampleRate, static_cast<int>(std::ceil(modCentreDelay + maxModDepth)) + 1, samplesPerBlock);
+    
+    // Each side of the predelay is a single channel. A fresh line is made so
+    // a lower sample rate than last time gives the memory back.
+    const double preDelaySamples = (sampleRate * preDelayTimeMs) / 1000.0f;
+    const int preDelayCapacity = static_cast<int>(std::ceil(preDelaySamples)) + 1;
+    
+    auto monoSpec = spec;
+    monoSpec.numChannels = 1;
+    
+    path.preDelayL = LinearDelayLine<SampleType>(preDelayCapacity);
+    path.preDelayR = LinearDelayLine<SampleType>(preDelayCapacity);
+    path.preDelayL.prepare(monoSpec);
+    path.preDelayR.prepare(monoSpec);
+    path.preDelayL.setDelay(static_cast<SampleType>(preDelaySamples));
+    path.preDelayR.setDelay(static_cast<SampleType>(preDelaySamples));
+    
+    getScratchBuffers<SampleType>().prepare(juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()),
+                                            samplesPerBlock);
+    
+    path.bypassDelay.prepare(spec);
+    path.bypassDelay.setMaximumDelayInSamples(juce::jmax(1, dsp.fuzz.getMaxLatencyInSamples()));
+    path.bypassDelay.reset();
 }
 
 
@@ -177,6 +323,8 @@ void verbMASCHINEAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    scratchBuffers.release();
+    doubleScratchBuffers.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -206,6 +354,18 @@ bool verbMASCHINEAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 #endif
 
 void verbMASCHINEAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer, processChunkForLayout);
+}
+
+void verbMASCHINEAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer, processDoubleChunkForLayout);
+}
+
+template <typename SampleType>
+void verbMASCHINEAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer,
+                                                ChunkProcessor<SampleType> processChunkForPrecision)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -214,279 +374,487 @@ void verbMASCHINEAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
-    juce::AudioBuffer<float> bypassBuffer;
-    bypassBuffer.makeCopyOf(buffer);
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
-    juce::AudioBuffer<float> processedDryBuffer;
-    processedDryBuffer.makeCopyOf(dryBuffer);
+    const int maxChunkSize = getScratchBuffers<SampleType>().getMaxBlockSize();
+    jassert(maxChunkSize > 0); // processBlock called without prepareToPlay, or in the other precision
+    if(maxChunkSize <= 0 || processChunkForPrecision == nullptr)
+        return;
     
-    bool isBypassed = apvts.getRawParameterValue("BYPASS")->load() >= 0.5f;
-    if(!isBypassed)
+    jassert(buffer.getNumChannels() >= numEngineChannels); // layout changed without prepareToPlay
+    if(buffer.getNumChannels() < numEngineChannels)
+        return;
+    
+    updateRenderMode();
+    
+    const int totalNumSamples = buffer.getNumSamples();
+    
+    dsp.telemetry.begin(totalNumSamples);
+    
+    // The block is worked through up to each point of the control grid, so a
+    // sub-block cut by the end of a host block is finished in the next one.
+    for(int start = 0; start < totalNumSamples;)
+    {
+        if(controlPhase == 0)
+            updateControls();
+        
+        int numSamples = juce::jmin(controlBlockSize - controlPhase, maxChunkSize, totalNumSamples - start);
+        
+        // Asleep, a chunk stops short of the first sample that isn't silent,
+        // so the chain wakes exactly there wherever the host's blocks begin.
+        if(sleeping)
+        {
+            const int numSilent = countSilentSamples(buffer, start, numSamples);
+            if(numSilent > 0)
+                numSamples = numSilent;
+        }
+        
+        juce::AudioBuffer<SampleType> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                            start, numSamples);
+        
+        // JUCE's plugin wrappers don't pass on the host's silence flags, so
+        // the input is always scanned.
+        const bool inputSilent = sleepWhenSilent && chunk.getMagnitude(0, numSamples) < silenceThreshold;
+        
+        dsp.telemetry.addInput(chunk, numEngineChannels);
+        
+        // The first sound is processed from its first sample with the state
+        // the chain went to sleep with.
+        if(sleeping && ! inputSilent)
+            sleeping = false;
+        
+        if(sleeping)
+        {
+            sleepChunk(chunk);
+            dsp.telemetry.addSilence(numSamples);
+            analyzerFeed.writeSilence(numSamples);
+        }
+        else
+        {
+            (this->*processChunkForPrecision)(chunk);
+            dsp.telemetry.addOutput(chunk, numEngineChannels);
+            
+            // The tail envelope is only checked where a sub-block ends, so it
+            // is read at the same points however the host's blocks cut it.
+            const bool endsSubBlock = controlPhase + numSamples == controlBlockSize;
+            const float tailEnergy = (! endsSubBlock || parameters.get().bypass)
+                                   ? 0.0f : juce::jmax(dsp.tailEnvelopeL, dsp.tailEnvelopeR);
+            
+            if(! inputSilent || tailEnergy >= silenceThreshold || chunk.getMagnitude(0, numSamples) >= silenceThreshold)
+                subBlockQuiet = false;
+        }
+        
+        start += numSamples;
+        controlPhase = (controlPhase + numSamples) % controlBlockSize;
+        
+        // Going to sleep is decided per whole sub-block too.
+        if(controlPhase == 0)
+        {
+            quietSamples = subBlockQuiet ? quietSamples + controlBlockSize : 0;
+            sleeping = quietSamples >= quietSamplesToSleep;
+            subBlockQuiet = true;
+        }
+    }
+    
+    telemetryFeed.push(dsp.telemetry.finish(numEngineChannels));
+}
+
+void verbMASCHINEAudioProcessor::updateControls()
+{
+    // One snapshot per sub-block; GAIN, VERB and VOL then ramp per sample
+    // towards it. The stages read the rest where they run, and their setters
+    // only act on a change, which can now only come at the grid.
+    const auto& params = parameters.update();
+    dsp.gainRamp.setTarget(params.gain);
+    dsp.verbRamp.setTarget(params.verb);
+    dsp.volRamp.setTarget(params.volGain);
+    
+    updateFuzzQuality();
+}
+
+template <typename SampleType>
+void verbMASCHINEAudioProcessor::sleepChunk(juce::AudioBuffer<SampleType>& buffer)
+{
+    // Everything is below the silence threshold, so the output is exact
+    // zeros and the DSP state is left as it was. The ramps still move so
+    // they end up where they would have.
+    buffer.clear();
+    
+    const int numSamples = buffer.getNumSamples();
+    dsp.gainRamp.advance(numSamples);
+    dsp.verbRamp.advance(numSamples);
+    dsp.volRamp.advance(numSamples);
+    
+    dsp.telemetry.setTail(0.0f, 0.0f);
+}
+
+template <typename SampleType>
+int verbMASCHINEAudioProcessor::countSilentSamples(const juce::AudioBuffer<SampleType>& buffer, int start, int numSamples)
+{
+    for(int i = 0; i < numSamples; ++i)
+    {
+        for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            if(std::abs(buffer.getSample(channel, start + i)) >= silenceThreshold)
+                return i;
+        }
+    }
+    
+    return numSamples;
+}
+
+template <int numChannels, typename SampleType>
+void verbMASCHINEAudioProcessor::processChunk(juce::AudioBuffer<SampleType>& buffer)
+{
+    using Arena = ScratchBufferArena<SampleType>;
+    auto& scratch = getScratchBuffers<SampleType>();
+    auto& path = dsp.path<SampleType>();
+    
+    auto& processedDryBuffer = scratch.copyInto(Arena::processedDry, buffer);
+    
+    analyzerFeed.write(AnalyzerFeed::dry, buffer.getReadPointer(0),
+                       numChannels > 1 ? buffer.getReadPointer(1) : nullptr, buffer.getNumSamples());
+    
+    const int numChunkSamples = buffer.getNumSamples();
+    dsp.gainRamp.advance(numChunkSamples);
+    dsp.verbRamp.advance(numChunkSamples);
+    dsp.volRamp.advance(numChunkSamples);
+    
+    dsp.telemetry.setGate(1.0f, 1.0f);
+    
+    const bool bypassed = parameters.get().bypass;
+    
+    // Keeps the bypassed signal in time with the fuzz latency. The line is fed
+    // whether or not BYPASS is on, so turning it on plays the input that just
+    // came in rather than what was left from the last time.
+    if(dsp.fuzz.getLatencyInSamples() > 0)
+    {
+        for(int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* channelData = buffer.getWritePointer(channel);
+            
+            for(int i = 0; i < numChunkSamples; ++i)
+            {
+                path.bypassDelay.pushSample(channel, channelData[i]);
+                const SampleType delayed = path.bypassDelay.popSample(channel);
+                
+                if(bypassed)
+                    channelData[i] = delayed;
+            }
+        }
+    }
+    
+    if(bypassed)
+    {
+        dsp.telemetry.setTail(0.0f, 0.0f);
+        analyzerFeed.writeSilence(AnalyzerFeed::fuzzed, numChunkSamples);
+        analyzerFeed.writeSilence(AnalyzerFeed::wet, numChunkSamples);
+    }
+    else
     {
         // === Gain on processedDryBuffer === //
-        float gainParam = apvts.getRawParameterValue("GAIN")->load();
-        float shaped = std::pow(gainParam, 2.2f);
-        float drive1 = juce::jmap(shaped, 1.0f, 8.0f);
-        float drive2 = juce::jmap(shaped, 1.0f, 2.5f);
+        const float gainStart = dsp.gainRamp.getBlockStart();
+        const float gainEnd = dsp.gainRamp.getBlockEnd();
+        const float gainParam = juce::jmax(gainStart, gainEnd);
 
         float gateThreshold = 0.01f;
         float gateReleaseRate = 0.9995f;
         float gateAttackRate = 0.3f;
-        static float gateEnvL = 0.0f;
-        static float gateEnvR = 0.0f;
 
-        auto softClip = [](float x) { return x / (1.0f + std::abs(x)); };
-        auto hardClip = [](float x) { return juce::jlimit(-0.4f, 0.4f, x); };
+        auto gateGain = [&](float envelope)
+        {
+            const float gainCurve = juce::jlimit(0.0f, 1.0f, (envelope - gateThreshold) / (0.05f - gateThreshold));
+            return gainCurve * gainCurve;
+        };
 
-        if (gainParam > 0.0001f)
         {
-            for (int channel = 0; channel < processedDryBuffer.getNumChannels(); ++channel)
+            VERBMASCHINE_TIME_STAGE(stageProfiler, fuzzGate);
+            
+            if (!dsp.fuzz.isPassThrough(gainParam))
+                dsp.fuzz.process(processedDryBuffer, gainStart, gainEnd);
+
+            if (gainParam > 0.0001f)
             {
-                auto* channelData = processedDryBuffer.getWritePointer(channel);
-                float& envelope = (channel == 0) ? gateEnvL : gateEnvR;
-                
-                for (int i = 0; i < processedDryBuffer.getNumSamples(); ++i)
+                for (int channel = 0; channel < numChannels; ++channel)
                 {
-                    float sample = channelData[i];
-                    
-                    float stage1 = softClip(sample * drive1);
-                    float stage2 = hardClip(stage1 * drive2);
-                    float mixed = juce::jmap(gainParam, sample, stage2);
+                    auto* channelData = processedDryBuffer.getWritePointer(channel);
+                    float& envelope = (channel == 0) ? dsp.gateEnvelopeL : dsp.gateEnvelopeR;
+                
+                    for (int i = 0; i < processedDryBuffer.getNumSamples(); ++i)
+                    {
+                        SampleType mixed = channelData[i];
                     
-                    float absMixed = std::abs(mixed);
-                    envelope = (absMixed > envelope)
-                    ? gateAttackRate * absMixed + (1.0f - gateAttackRate) * envelope
-                    : gateReleaseRate;
+                        float absMixed = static_cast<float>(std::abs(mixed));
+                        envelope = (absMixed > envelope)
+                        ? gateAttackRate * absMixed + (1.0f - gateAttackRate) * envelope
+                        : gateReleaseRate;
                         
-                    float gainCurve = juce::jlimit(0.0f, 1.0f, (envelope - gateThreshold) / (0.05f - gateThreshold));
-                    gainCurve = std::pow(gainCurve, 2.0f);
-                    
-                    channelData[i] = mixed * gainCurve;
+                        channelData[i] = mixed * gateGain(envelope);
+                    }
                 }
+            
+                dsp.telemetry.setGate(gateGain(dsp.gateEnvelopeL), gateGain(dsp.gateEnvelopeR));
             }
         }
+        
+        analyzerFeed.write(AnalyzerFeed::fuzzed, processedDryBuffer.getReadPointer(0),
+                           numChannels > 1 ? processedDryBuffer.getReadPointer(1) : nullptr,
+                           processedDryBuffer.getNumSamples());
 
-        juce::AudioBuffer<float> wetBuffer;
-        wetBuffer.makeCopyOf(processedDryBuffer);
+        auto& wetBuffer = scratch.copyInto(Arena::wet, processedDryBuffer);
+        
+        const int numSamples = wetBuffer.getNumSamples();
+        
+        SampleType* wetL = wetBuffer.getWritePointer(0);
+        SampleType* wetR = numChannels > 1 ? wetBuffer.getWritePointer(1) : nullptr;
         
         // === Reverb Predelay === //
-        for(int i = 0; i < wetBuffer.getNumSamples(); ++i)
+        WetStages::PreDelay<SampleType> preDelayStage {path.preDelayL, path.preDelayR};
         {
-            float sampleL = wetBuffer.getSample(0, i);
-            float sampleR = wetBuffer.getNumChannels() > 1 ? wetBuffer.getSample(1, i) : sampleL;
-            
-            preDelayL.pushSample(0, sampleL);
-            preDelayR.pushSample(0, sampleR);
-            
-            float delayedL = preDelayL.popSample(0);
-            float delayedR = preDelayR.popSample(0);
-            
-            wetBuffer.setSample(0, i, delayedL);
-            if (wetBuffer.getNumChannels() > 1)
-                wetBuffer.setSample(1, i, delayedR);
+            VERBMASCHINE_TIME_STAGE(stageProfiler, preDelay);
+            processFusedInPlace<numChannels>(wetL, wetR, numSamples, preDelayStage);
         }
 
         // === Reverb and Filtering === //
-        reverbParams.roomSize = 0.95f;
-        reverbParams.damping = 0.1f;
-        reverbParams.wetLevel = 1.0f;
-        reverbParams.dryLevel = 0.0f;
-        reverbParams.width = 0.8f;
-        reverbParams.freezeMode = 0.0f;
-        
-        reverbL.setParameters(reverbParams);
-        reverbR.setParameters(reverbParams);
-
-        juce::dsp::AudioBlock<float> block(wetBuffer);
-        auto blockL = block.getSingleChannelBlock(0);
-        auto blockR = block.getSingleChannelBlock(1);
-        juce::dsp::ProcessContextReplacing<float> contextL(blockL);
-        juce::dsp::ProcessContextReplacing<float> contextR(blockR);
-        
-        reverbL.processMono(wetBuffer.getWritePointer(0), wetBuffer.getNumSamples());
-        reverbHighCutL.process(contextL);
-
-        if (wetBuffer.getNumChannels() > 1)
-            {
-                reverbR.processMono(wetBuffer.getWritePointer(1), wetBuffer.getNumSamples());
-                reverbHighCutR.process(contextR);
-            }
-
-        auto mapTailCutoff = [](float level)
+        dsp.reverb.setMixing(static_cast<FdnMixing>(parameters.get().fdnMixing));
+        dsp.reverb.setEngine(parameters.get().reverbEngine);
         {
-            float db = juce::Decibels::gainToDecibels(level + 1e-5f);
-            db = juce::jlimit(-60.0f, 0.0f, db);
-            
-            float norm = juce::jmap(db, -60.0f, 0.0f, 1.0f, 0.0f);
-            float shapedNorm = std::pow(norm, 2.5f);
-            
-            return juce::jmap(shapedNorm, 40.0f, 6000.0f);
-        };
-
-        float tailsReleaseRate = 0.9995f;
-        
-        for(int i = 0; i < wetBuffer.getNumSamples(); ++i)
-        {
-            float sampleL = std::abs(wetBuffer.getSample(0, i));
-            float sampleR = wetBuffer.getNumChannels() > 1 ? std::abs(wetBuffer.getSample(1, i)) : sampleL;
-            
-            tailEnvelopeL = std::max(sampleL, tailEnvelopeL * tailsReleaseRate);
-            tailEnvelopeR = std::max(sampleR, tailEnvelopeR * tailsReleaseRate);
+            VERBMASCHINE_TIME_STAGE(stageProfiler, reverb);
+            dsp.reverb.process<numChannels>(wetL, wetR, numSamples);
         }
         
-        tailCutoffL.setTargetValue(mapTailCutoff(tailEnvelopeL));
-        tailCutoffR.setTargetValue(mapTailCutoff(tailEnvelopeR));
+        if constexpr(std::is_same_v<SampleType, double>)
+            processWetPath<numChannels>(dsp.precisionWetFilters, buffer, processedDryBuffer, wetBuffer);
+        else if(renderModeActive)
+            processWetPath<numChannels>(dsp.precisionWetFilters, buffer, processedDryBuffer, wetBuffer);
+        else
+            processWetPath<numChannels>(dsp.wetFilters, buffer, processedDryBuffer, wetBuffer);
         
-        for(int i = 0; i < wetBuffer.getNumSamples(); ++i)
-        {
-            float cutoffL = tailCutoffL.getNextValue();
-            float cutoffR = tailCutoffR.getNextValue();
-            
-            tailFilterL.setCutoffFrequency(cutoffL);
-            tailFilterR.setCutoffFrequency(cutoffR);
-            
-            float wetSampleL = wetBuffer.getSample(0, i);
-            float wetSampleR = wetBuffer.getNumChannels() > 1 ? wetBuffer.getSample(1, i) : wetSampleL;
-            
-            wetSampleL = tailFilterL.processSample(0, wetSampleL);
-            if(wetBuffer.getNumChannels() > 1)
-            {
-                wetSampleR = tailFilterR.processSample(0, wetSampleR);
-            }
-            
-            wetBuffer.setSample(0, i, wetSampleL);
-            if (wetBuffer.getNumChannels() > 1)
-                wetBuffer.setSample(1, i, wetSampleR);
-        }
-        
-        // === Reverb Modulation === //
-        const float sampleRate = getSampleRate();
-        const float lfoIncrement = (2.0f * juce::MathConstants<float>::pi * lfoRateHz) / sampleRate;
+        analyzerFeed.write(AnalyzerFeed::wet, wetL, wetR, numSamples);
+    }
+}
+
+template <int numChannels, typename SampleType, typename StateType>
+void verbMASCHINEAudioProcessor::processWetPath(WetFilterBank<StateType>& filters,
+                                                juce::AudioBuffer<SampleType>& buffer,
+                                                const juce::AudioBuffer<SampleType>& processedDryBuffer,
+                                                juce::AudioBuffer<SampleType>& wetBuffer)
+{
+    const int numSamples = wetBuffer.getNumSamples();
+    auto& tailModulation = dsp.path<SampleType>().tailModulation;
+    
+    SampleType* wetL = wetBuffer.getWritePointer(0);
+    SampleType* wetR = numChannels > 1 ? wetBuffer.getWritePointer(1) : nullptr;
+    
+    auto mapTailCutoff = [](float level)
+    {
+        float db = FastMath::gainToDecibels(level + 1e-5f);
+        db = juce::jlimit(-60.0f, 0.0f, db);
         
-        for(int i = 0; i < wetBuffer.getNumSamples(); ++i)
-        {
-            float lfoValue = std::sin(lfoPhase);
-            float modulatedDelayMs = 10.0f + lfoValue * lfoDepthMs;
-            float maxDelayMs = (tailModDelayL.getMaximumDelayInSamples() * 1000.0f) / sampleRate;
-            modulatedDelayMs = juce::jlimit(0.0f, maxDelayMs, modulatedDelayMs);
-            
-            tailModDelayL.setDelay(modulatedDelayMs);
-            tailModDelayR.setDelay(modulatedDelayMs);
-            
-            float sampleL = wetBuffer.getSample(0, i);
-            float sampleR = wetBuffer.getNumSamples() > 1 ? wetBuffer.getSample(1, i) : sampleL;
-            
-            tailModDelayL.pushSample(0, sampleL);
-            tailModDelayR.pushSample(0, sampleR);
-            
-            float modSampleL = tailModDelayL.popSample(0);
-            float modSampleR = tailModDelayR.popSample(0);
-            
-            wetBuffer.setSample(0, i, modSampleL);
-            if(wetBuffer.getNumChannels() > 1)
-                wetBuffer.setSample(1, i, modSampleR);
-            
-            lfoPhase += lfoIncrement;
-            if(lfoPhase >= 2.0f * juce::MathConstants<float>::pi)
-                lfoPhase -= 2.0f * juce::MathConstants<float>::pi;
-        }
+        float norm = juce::jmap(db, -60.0f, 0.0f, 1.0f, 0.0f);
+        float shapedNorm = FastMath::pow(norm, 2.5f);
         
-        // Measure tails
-        float tailEnvL = 0.0f;
-        float tailEnvR = 0.0f;
-        const float tailRelease = 0.9995;
-        float verbAmount = apvts.getRawParameterValue("VERB")->load();
+        return juce::jmap(shapedNorm, 40.0f, 6000.0f);
+    };
+
+    // === High Cut, Envelope and Tail Filter === //
+    // At the start of each control sub-block the envelope so far is mapped to
+    // a cutoff, and the cutoff to filter coefficients. The tail filter glides
+    // to them across the sub-block, so it needs no tan() per sample.
+    WetStages::StaticFilter<StateType> highCutStage {filters.reverbHighCutL, filters.reverbHighCutR};
+    WetStages::EnvelopeFollower tailEnvelopeStage {dsp.tailEnvelopeL, dsp.tailEnvelopeR, 0.9995f};
+    
+    {
+        VERBMASCHINE_TIME_STAGE(stageProfiler, tailFilter);
         
-        for(int i = 0; i < wetBuffer.getNumSamples(); ++i)
+        if(controlPhase == 0)
         {
-            float tailSampleL = std::abs(wetBuffer.getSample(0, i));
-            float tailSampleR = wetBuffer.getNumChannels() > 1
-                ? std::abs(wetBuffer.getSample(1, i))
-                : tailSampleL;
-            
-            tailEnvL = std::max(tailSampleL, tailEnvL * tailRelease);
-            tailEnvR = std::max(tailSampleR, tailEnvR * tailRelease);
+            const float inverseSampleRate = 1.0f / static_cast<float>(getSampleRate());
             
-            float scaledTailL = tailEnvL * verbAmount;
-            float scaledTailR = tailEnvR * verbAmount;
+            dsp.tailCutoffL.setTargetValue(mapTailCutoff(dsp.tailEnvelopeL));
+            const float cutoffL = dsp.tailCutoffL.skip(controlBlockSize);
+            filters.tailFilterL.rampTo(static_cast<StateType>(tables->tanPi(cutoffL * inverseSampleRate)), controlBlockSize);
             
-            tailLevelL.store(scaledTailL);
-            tailLevelR.store(scaledTailR);
-        }
-
-        // === Final Wet/Dry Mix === //
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-        {
-            auto* wet = wetBuffer.getReadPointer(channel);
-            auto* dry = processedDryBuffer.getReadPointer(channel);
-            auto* out = buffer.getWritePointer(channel);
-
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            if constexpr(numChannels > 1)
             {
-                out[i] = dry[i] * (1.0f - verbAmount) + wet[i] * verbAmount;
+                dsp.tailCutoffR.setTargetValue(mapTailCutoff(dsp.tailEnvelopeR));
+                const float cutoffR = dsp.tailCutoffR.skip(controlBlockSize);
+                filters.tailFilterR.rampTo(static_cast<StateType>(tables->tanPi(cutoffR * inverseSampleRate)), controlBlockSize);
             }
         }
         
-        // === Dark / Light Tilt EQ === //
-        juce::dsp::AudioBlock<float> finalBlock(buffer);
-        auto finalBlockL = finalBlock.getSingleChannelBlock(0);
-        auto finalBlockR = finalBlock.getSingleChannelBlock(1);
-        juce::dsp::ProcessContextReplacing<float> finalContextL(finalBlockL);
-        juce::dsp::ProcessContextReplacing<float> finalContextR(finalBlockR);
-        
-        updateTiltEQ();
+        processFusedInPlace<numChannels>(wetL, wetR, numSamples, highCutStage, tailEnvelopeStage);
         
-        tiltLowShelfL.process(finalContextL);
-        tiltLowShelfR.process(finalContextR);
-        tiltHighShelfL.process(finalContextL);
-        tiltHighShelfR.process(finalContextR);
+        filters.tailFilterL.processRamped(wetL, numSamples);
+        if constexpr(numChannels > 1)
+            filters.tailFilterR.processRamped(wetR, numSamples);
+    }
+    
+    // === Modulation === //
+    tailModulation.setRate(parameters.get().modRate);
+    tailModulation.setDepth(parameters.get().modDepth * maxModDepth);
+    {
+        VERBMASCHINE_TIME_STAGE(stageProfiler, modulation);
+        tailModulation.template process<numChannels>(wetL, wetR, numSamples);
+    }
+    
+    // === Mix, Tilt and Volume === //
+    filters.tilt.setTilt(parameters.get().darkLight);
+    
+    float tailEnvL = 0.0f;
+    float tailEnvR = 0.0f;
+    
+    WetStages::EnvelopeFollower tailMeterStage {tailEnvL, tailEnvR, 0.9995f};
+    WetStages::DryWetMix<SampleType> mixStage {processedDryBuffer.getReadPointer(0),
+                                               processedDryBuffer.getReadPointer(numChannels > 1 ? 1 : 0),
+                                               dsp.verbRamp.getValues()};
+    
+    SampleType* outL = buffer.getWritePointer(0);
+    SampleType* outR = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+    
+    {
+        VERBMASCHINE_TIME_STAGE(stageProfiler, mix);
+        processFused<numChannels>(wetL, wetR, outL, outR, numSamples, tailMeterStage, mixStage);
+    }
+    
+    {
+        VERBMASCHINE_TIME_STAGE(stageProfiler, tilt);
+        filters.tilt.template process<numChannels>(outL, outR, numSamples);
+    }
+    
+    {
+        VERBMASCHINE_TIME_STAGE(stageProfiler, volume);
+        dsp.volRamp.applyGain(outL, numSamples);
+        if constexpr(numChannels > 1)
+            dsp.volRamp.applyGain(outR, numSamples);
+    }
+    
+    dsp.telemetry.setTail(tailEnvL * dsp.verbRamp.getBlockEnd(), tailEnvR * dsp.verbRamp.getBlockEnd());
+}
 
-        // === Output Volume Control === //
-        auto volDb = apvts.getRawParameterValue("VOL")->load();
-        targetGain = juce::Decibels::decibelsToGain(volDb);
+void verbMASCHINEAudioProcessor::updateRenderMode()
+{
+    if(isNonRealtime() == renderModeActive)
+        return;
+    
+    renderModeActive = isNonRealtime();
+    applyRenderMode();
+    updateFuzzQuality();
+}
 
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-        {
-            auto* channelData = buffer.getWritePointer(channel);
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-            {
-                channelData[i] *= targetGain;
-            }
-        }
+void verbMASCHINEAudioProcessor::applyRenderMode()
+{
+    // Filter state is carried across precisions and both interpolators read
+    // the same delay history, so none of this is audible as a discontinuity.
+    // Double precision processing always runs the double state filters.
+    if(! isUsingDoublePrecision())
+    {
+        if(renderModeActive)
+            dsp.precisionWetFilters.copyStateFrom(dsp.wetFilters);
+        else
+            dsp.wetFilters.copyStateFrom(dsp.precisionWetFilters);
     }
     
-    measureLevels(bypassBuffer, buffer);
+    const auto interpolation = renderModeActive ? DelayInterpolation::lagrange3rd
+                                                : DelayInterpolation::linear;
+    dsp.floatPath.tailModulation.setInterpolation(interpolation);
+    dsp.doublePath.tailModulation.setInterpolation(interpolation);
 }
 
-void verbMASCHINEAudioProcessor::measureLevels(const juce::AudioBuffer<float>& inputBuffer,
-                                                       const juce::AudioBuffer<float>& outputBuffer)
+int verbMASCHINEAudioProcessor::getEffectiveFuzzQuality()
 {
-    const int numSamples = inputBuffer.getNumSamples();
-    const int numChannels = inputBuffer.getNumChannels();
+    if(renderModeActive)
+        return FuzzStage::numQualities - 1;
     
-    float inL = inputBuffer.getRMSLevel(0, 0, numSamples);
-    float inR = numChannels > 1 ? inputBuffer.getRMSLevel(1, 0, numSamples) : inL;
+    return parameters.get().fuzzQuality;
+}
+
+void verbMASCHINEAudioProcessor::updateFuzzQuality()
+{
+    int quality = getEffectiveFuzzQuality();
+    
+    if(quality == dsp.fuzz.getQuality())
+        return;
     
-    inputLevelL.store(inL);
-    inputLevelR.store(inR);
+    dsp.fuzz.setQuality(quality);
     
-    float outL = outputBuffer.getRMSLevel(0, 0, numSamples);
-    float outR = numChannels > 1 ? outputBuffer.getRMSLevel(1, 0, numSamples) : outL;
+    const int latency = dsp.fuzz.getLatencyInSamples();
+    setBypassDelay(latency);
     
-    outputLevelL.store(outL);
-    outputLevelR.store(outR);
+    // The host learns the new latency a message loop later, and then all at
+    // once, while FuzzStage fades between the old and new paths over its
+    // crossfade. For that long the audio is a blend of both latencies.
+    latencyToReport.store(latency);
+    triggerAsyncUpdate();
+}
+
+void verbMASCHINEAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(latencyToReport.load());
+}
+
+void verbMASCHINEAudioProcessor::setBypassDelay(int latency)
+{
+    // Only the active precision's delay line is prepared.
+    if(isUsingDoublePrecision())
+        dsp.doublePath.bypassDelay.setDelay(static_cast<double>(latency));
+    else
+        dsp.floatPath.bypassDelay.setDelay(static_cast<float>(latency));
 }
 
 //==============================================================================
 bool verbMASCHINEAudioProcessor::hasEditor() const
 {
+   #if VERBMASCHINE_HEADLESS
+    return false;
+   #else
     return true; // (change this to false if you choose to not supply an editor)
+   #endif
 }
 
 juce::AudioProcessorEditor* verbMASCHINEAudioProcessor::createEditor()
 {
+   #if VERBMASCHINE_HEADLESS
+    return nullptr;
+   #else
     return new verbMASCHINEAudioProcessorEditor (*this);
+   #endif
+}
+
+verbMASCHINEAudioProcessor::MemoryFootprint verbMASCHINEAudioProcessor::estimateMemoryFootprint() const
+{
+    // From the delay each line was asked to hold; its actual buffer is a
+    // little larger.
+    auto delayLineBytes = [](const auto& line, int numChannels, size_t sampleSize)
+    {
+        return (size_t) numChannels * (size_t) line.getMaximumDelayInSamples() * sampleSize;
+    };
+    
+    auto pathBytes = [&](const auto& path, int bypassChannels, size_t sampleSize)
+    {
+        // The precision not in use holds nothing.
+        if(path.tailModulation.getAllocatedBytes() == 0)
+            return (size_t) 0;
+        
+        return delayLineBytes(path.preDelayL, 1, sampleSize)
+             + delayLineBytes(path.preDelayR, 1, sampleSize)
+             + delayLineBytes(path.bypassDelay, bypassChannels, sampleSize)
+             + path.tailModulation.getAllocatedBytes();
+    };
+    
+    const int numChannels = getTotalNumOutputChannels();
+    
+    MemoryFootprint footprint;
+    footprint.processor = sizeof(*this);
+    footprint.delayLines = pathBytes(dsp.floatPath, numChannels, sizeof(float))
+                         + pathBytes(dsp.doublePath, numChannels, sizeof(double));
+    footprint.reverb = dsp.reverb.getAllocatedBytes();
+    footprint.fuzz = dsp.fuzz.getAllocatedBytes();
+    footprint.blockBuffers = scratchBuffers.getAllocatedBytes()
+                           + doubleScratchBuffers.getAllocatedBytes()
+                           + dsp.gainRamp.getAllocatedBytes()
+                           + dsp.verbRamp.getAllocatedBytes()
+                           + dsp.volRamp.getAllocatedBytes();
+    footprint.analyzer = analyzerFeed.getAllocatedBytes();
+    return footprint;
 }
 
 //==============================================================================
@@ -511,24 +879,3 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new verbMASCHINEAudioProcessor();
 }
-
-void verbMASCHINEAudioProcessor::updateTiltEQ()
-{
-    float tilt = apvts.getRawParameterValue("DARK_LIGHT")->load();
-    tilt = juce::jlimit(-1.0f, 1.0f, tilt);
-    tilt = std::tanh(tilt * 2.0f);
-    tilt = -tilt;
-    
-    float lowGainDb = tilt * 2.0f;
-    float highGainDb = tilt * 6.0f;
-    float freq = 800.0f;
-    float q = 0.707f;
-    
-    auto lowShelf = juce::dsp::IIR::Coefficients<float>::makeLowShelf(getSampleRate(), freq, q, juce::Decibels::decibelsToGain(lowGainDb));
-    auto highShelf = juce::dsp::IIR::Coefficients<float>::makeHighShelf(getSampleRate(), freq, q, juce::Decibels::gainToDecibels(highGainDb));
-    
-    tiltLowShelfL.coefficients = lowShelf;
-    tiltLowShelfR.coefficients = lowShelf;
-    tiltHighShelfL.coefficients = lowShelf;
-    tiltHighShelfR.coefficients = lowShelf;
-}
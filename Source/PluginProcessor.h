@@ -9,43 +9,94 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ScratchBufferArena.h"
+#include "DSPState.h"
+#include "SharedTables.h"
+#include "AnalyzerFeed.h"
+#include "StageProfiler.h"
+
+// Set by the command line tools in Tools/, which build the processor on its own.
+#ifndef VERBMASCHINE_HEADLESS
+ #define VERBMASCHINE_HEADLESS 0
+#endif
+
+// Samples per step of the control grid (see controlBlockSize). Any size
+// above 0 works; Tools/ checks the block size invariance at 32 and 64.
+#ifndef VERBMASCHINE_CONTROL_BLOCK_SIZE
+ #define VERBMASCHINE_CONTROL_BLOCK_SIZE 32
+#endif
 
 //==============================================================================
 /**
 */
-class verbMASCHINEAudioProcessor  : public juce::AudioProcessor
+class verbMASCHINEAudioProcessor  : public juce::AudioProcessor,
+                                    private juce::AsyncUpdater
 {
 public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts {*this, nullptr,
         "Parameters", createParameterLayout()};
     
-    float targetGain = 1.0f;
+    // One record per processBlock call, for the editor to drain. Records are
+    // dropped while nothing reads them.
+    SpscRing<TelemetryRecord, 128> telemetryFeed;
     
-    std::atomic<float> inputLevelL {0.0f}, inputLevelR {0.0f};
-    std::atomic<float> outputLevelL {0.0f}, outputLevelR {0.0f};
-    std::atomic<float> tailLevelL {0.0f}, tailLevelR {0.0f};
+    // Copies of the dry, fuzzed and wet signals while an analyser is open.
+    AnalyzerFeed analyzerFeed;
+    
+   #if VERBMASCHINE_STAGE_TIMING
+    // How long each stage of processBlock takes, for the editor's hidden
+    // overlay and the benchmark's results.
+    StageProfiler stageProfiler;
+   #endif
     
     juce::Reverb::Parameters reverbParams;
-    juce::Reverb reverbL, reverbR;
+    bool renderModeActive = false;
     
-    juce::dsp::StateVariableTPTFilter<float> reverbHighCutL, reverbHighCutR;
-    juce::dsp::StateVariableTPTFilter<float> tailFilterL, tailFilterR;
-    juce::SmoothedValue<float> tailCutoffL, tailCutoffR;
+    // The tail modulation times are in samples at every sample rate. MOD_DEPTH
+    // scales maxModDepth.
+    static constexpr float modCentreDelay = 10.0f;
+    static constexpr float maxModDepth = 100.0f;
     
-    float tailEnvelopeL = 0.0f, tailEnvelopeR = 0.0f;
+    // Fixed, and the predelay lines only have room for this much.
+    static constexpr float preDelayTimeMs = 80.0f;
     
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> tailModDelayL, tailModDelayR;
-    float lfoPhase = 0.0f;
-    float lfoRateHz = 0.6f;
-    float lfoDepthMs = 60.0f;
+    // Host blocks are cut into sub-blocks on a fixed grid of this many
+    // samples, which carries on from one block to the next. Parameters, ramp
+    // targets and the envelope driven tail filter cutoff only change at the
+    // grid, so the output doesn't depend on the host's block size.
+    static constexpr int controlBlockSize = VERBMASCHINE_CONTROL_BLOCK_SIZE;
+    static_assert(controlBlockSize > 0, "The control grid needs at least one sample per step");
     
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> preDelayL, preDelayR;
-    float preDelayTimeMs = 80.0f;
+    // Input, output and the wet tail below this (-100 dBFS) count as silence.
+    // After they have all been silent for a while the chain sleeps, outputting
+    // zeros without running any DSP, until the input is not silent any more.
+    static constexpr float silenceThreshold = 1.0e-5f;
+    static constexpr double maxTailSeconds = 30.0;
+    bool sleepWhenSilent = true;
+    bool isSleeping() const noexcept {return sleeping;}
     
-    juce::dsp::IIR::Filter<float> tiltLowShelfL, tiltLowShelfR;
-    juce::dsp::IIR::Filter<float> tiltHighShelfL, tiltHighShelfR;
+    DSPState dsp;
     
+    // Roughly what one instance holds, in bytes, after prepareToPlay(). It is
+    // an estimate: the JUCE delay lines and oversamplers don't report their
+    // allocations, so those are worked out from the sizes they were given,
+    // and allocator overhead isn't included. Memory shared between instances
+    // (SharedTables) and JUCE's own parameter and state objects aren't
+    // counted either.
+    struct MemoryFootprint
+    {
+        size_t processor = 0;    // the processor object, DSPState and the feeds inline
+        size_t delayLines = 0;   // predelay, tail modulation and the bypass delay
+        size_t reverb = 0;       // every reverb network and the engine crossfade
+        size_t fuzz = 0;         // oversampling and crossfade buffers
+        size_t blockBuffers = 0; // scratch buffers and parameter ramps
+        size_t analyzer = 0;     // only once an analyser has been opened
+        
+        size_t getTotal() const noexcept {return processor + delayLines + reverb + fuzz + blockBuffers + analyzer;}
+    };
+    
+    MemoryFootprint estimateMemoryFootprint() const;
     
     //==============================================================================
     verbMASCHINEAudioProcessor();
@@ -60,6 +111,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override {return true;}
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -85,9 +138,71 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
 private:
-    void updateTiltEQ();
-    void measureLevels(const juce::AudioBuffer<float>& inputBuffer,
-                       const juce::AudioBuffer<float>& outputBuffer);
+    ScratchBufferArena<float> scratchBuffers;
+    ScratchBufferArena<double> doubleScratchBuffers;
+    
+    ParameterCache parameters {apvts};
+    juce::SharedResourcePointer<SharedTables> tables;
+    
+    // The engine is compiled for mono and stereo, in float and double, and
+    // prepareToPlay() picks the one matching the bus layout and the host's
+    // processing precision, so no inner loop has to check either.
+    template <typename SampleType>
+    using ChunkProcessor = void (verbMASCHINEAudioProcessor::*)(juce::AudioBuffer<SampleType>&);
+    ChunkProcessor<float> processChunkForLayout = nullptr;
+    ChunkProcessor<double> processDoubleChunkForLayout = nullptr;
+    int numEngineChannels = 0;
+    
+    double tailLengthSeconds = 0.0;
+    int quietSamples = 0;
+    int quietSamplesToSleep = 0;
+    bool sleeping = false;
+    
+    // Where the next sample falls in the current control sub-block, and
+    // whether everything in it so far was quiet.
+    int controlPhase = 0;
+    bool subBlockQuiet = true;
+    
+    // A latency change on the audio thread is reported to the host from the
+    // message thread, since hosts may reallocate when told.
+    std::atomic<int> latencyToReport {0};
+    
+    double measureReverbDecaySeconds(double sampleRate, int engine) const;
+    
+    template <typename SampleType>
+    ScratchBufferArena<SampleType>& getScratchBuffers() noexcept
+    {
+        if constexpr(std::is_same_v<SampleType, double>)
+            return doubleScratchBuffers;
+        else
+            return scratchBuffers;
+    }
+    
+    template <typename SampleType>
+    void prepareSampleTypeState(const juce::dsp::ProcessSpec& spec);
+    
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, ChunkProcessor<SampleType> processChunkForPrecision);
+    
+    template <int numChannels, typename SampleType>
+    void processChunk(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType>
+    void sleepChunk(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType>
+    static int countSilentSamples(const juce::AudioBuffer<SampleType>& buffer, int start, int numSamples);
+    void setBypassDelay(int latency);
+    void handleAsyncUpdate() override;
+    void updateControls();
+    void updateFuzzQuality();
+    int getEffectiveFuzzQuality();
+    void updateRenderMode();
+    void applyRenderMode();
+    
+    template <int numChannels, typename SampleType, typename StateType>
+    void processWetPath(WetFilterBank<StateType>& filters,
+                        juce::AudioBuffer<SampleType>& buffer,
+                        const juce::AudioBuffer<SampleType>& processedDryBuffer,
+                        juce::AudioBuffer<SampleType>& wetBuffer);
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (verbMASCHINEAudioProcessor)
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    PrecisionFilters.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "TiltEQ.h"
+
+// Mono filter whose coefficients and state use StateType, independent of the
+// sample type of the audio passing through. The float version reproduces
+// juce::dsp::StateVariableTPTFilter exactly; the double version is what the
+// offline render mode runs.
+// copyStateFrom() moves the state across precisions so the two can be
+// swapped mid-stream without a click.
+template <typename StateType>
+class TptFilter
+{
+public:
+    using Type = juce::dsp::StateVariableTPTFilterType;
+
+    void setType(Type newType) {type = newType;}
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        update();
+        reset();
+    }
+
+    void reset()
+    {
+        s1 = s2 = StateType();
+        rampStepsLeft = 0;
+    }
+
+    void setCutoffFrequency(float newCutoff) noexcept
+    {
+        cutoff = newCutoff;
+        update();
+    }
+
+    void setResonance(float newResonance) noexcept
+    {
+        resonance = newResonance;
+        update();
+    }
+
+    // Sets the cutoff from a precomputed g = tan(pi fc / fs).
+    void setG(StateType newG) noexcept
+    {
+        g = newG;
+        h = computeH(g);
+        rampStepsLeft = 0;
+    }
+
+    // Starts g and h gliding linearly to the values for targetG over the
+    // next numSteps samples, so the cutoff can move at control rate without
+    // a tan() or a division per sample. processRamped() carries the glide
+    // on across calls.
+    void rampTo(StateType targetG, int numSteps) noexcept
+    {
+        rampTargetG = targetG;
+        rampTargetH = computeH(targetG);
+        rampStepsLeft = juce::jmax(1, numSteps);
+
+        const StateType steps = static_cast<StateType>(rampStepsLeft);
+        gStep = (rampTargetG - g) / steps;
+        hStep = (rampTargetH - h) / steps;
+    }
+
+    template <typename SampleType>
+    void processRamped(SampleType* samples, int numSamples) noexcept
+    {
+        const int rampSamples = juce::jmin(numSamples, rampStepsLeft);
+
+        for(int i = 0; i < rampSamples; ++i)
+        {
+            g += gStep;
+            h += hStep;
+            samples[i] = processSample(samples[i]);
+        }
+
+        if(rampSamples > 0 && (rampStepsLeft -= rampSamples) == 0)
+        {
+            g = rampTargetG;
+            h = rampTargetH;
+        }
+
+        for(int i = rampSamples; i < numSamples; ++i)
+            samples[i] = processSample(samples[i]);
+    }
+
+    template <typename SampleType>
+    SampleType processSample(SampleType input) noexcept
+    {
+        const StateType x = static_cast<StateType>(input);
+
+        auto yHP = h * (x - s1 * (g + R2) - s2);
+        auto yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+        auto yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        switch(type)
+        {
+            case Type::lowpass:  return static_cast<SampleType>(yLP);
+            case Type::bandpass: return static_cast<SampleType>(yBP);
+            case Type::highpass: return static_cast<SampleType>(yHP);
+            default:             return static_cast<SampleType>(yLP);
+        }
+    }
+
+    template <typename OtherType>
+    void copyStateFrom(const TptFilter<OtherType>& other) noexcept
+    {
+        s1 = static_cast<StateType>(other.s1);
+        s2 = static_cast<StateType>(other.s2);
+    }
+
+    // For filters moved with setG() or rampTo(), whose cutoff is only known
+    // through g. h and a glide in progress are derived again in this
+    // precision.
+    template <typename OtherType>
+    void copyCutoffFrom(const TptFilter<OtherType>& other) noexcept
+    {
+        setG(static_cast<StateType>(other.g));
+
+        if(other.rampStepsLeft > 0)
+            rampTo(static_cast<StateType>(other.rampTargetG), other.rampStepsLeft);
+    }
+
+private:
+    template <typename> friend class TptFilter;
+
+    void update() noexcept
+    {
+        g = static_cast<StateType>(std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate));
+        R2 = static_cast<StateType>(1.0 / resonance);
+        h = computeH(g);
+    }
+
+    StateType computeH(StateType newG) const noexcept
+    {
+        return static_cast<StateType>(1.0 / (1.0 + R2 * newG + newG * newG));
+    }
+
+    Type type = Type::lowpass;
+    double sampleRate = 44100.0;
+    float cutoff = 1000.0f;
+    float resonance = 1.0f / juce::MathConstants<float>::sqrt2;
+    StateType g {}, h {}, R2 {};
+    StateType s1 {}, s2 {};
+
+    StateType rampTargetG {}, rampTargetH {}, gStep {}, hStep {};
+    int rampStepsLeft = 0;
+};
+
+// Every stateful filter on the wet path, in one precision.
+template <typename StateType>
+struct WetFilterBank
+{
+    TptFilter<StateType> reverbHighCutL, reverbHighCutR;
+    TptFilter<StateType> tailFilterL, tailFilterR;
+    TiltEQ<StateType> tilt;
+
+    void prepare(double sampleRate)
+    {
+        for(auto* filter : {&reverbHighCutL, &reverbHighCutR})
+        {
+            filter->setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+            filter->setCutoffFrequency(15000.0f);
+            filter->setResonance(0.3f);
+            filter->prepare(sampleRate);
+        }
+
+        for(auto* filter : {&tailFilterL, &tailFilterR})
+        {
+            filter->setType(juce::dsp::StateVariableTPTFilterType::highpass);
+            filter->setResonance(0.5f);
+            filter->prepare(sampleRate);
+        }
+
+        tilt.prepare(sampleRate);
+    }
+
+    template <typename OtherType>
+    void copyStateFrom(const WetFilterBank<OtherType>& other) noexcept
+    {
+        reverbHighCutL.copyStateFrom(other.reverbHighCutL);
+        reverbHighCutR.copyStateFrom(other.reverbHighCutR);
+        tailFilterL.copyStateFrom(other.tailFilterL);
+        tailFilterR.copyStateFrom(other.tailFilterR);
+        tailFilterL.copyCutoffFrom(other.tailFilterL);
+        tailFilterR.copyCutoffFrom(other.tailFilterR);
+        tilt.copyStateFrom(other.tilt);
+    }
+};
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ReverbEngine.h"
+
+void ReverbEngine::prepare(double sampleRate, int maxBlockSize)
+{
+    freeverbNetwork.prepare(sampleRate);
+    fdn8Network.prepare(sampleRate);
+    fdn16Network.prepare(sampleRate);
+
+    maxBlock = juce::jmax(1, maxBlockSize);
+    fadeStorage.calloc(static_cast<size_t>(maxBlock) * 2);
+    fadeL = fadeStorage.get();
+    fadeR = fadeStorage.get() + maxBlock;
+
+    crossfadeLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.05));
+    crossfadeSamplesLeft = 0;
+    needsClear.fill(false);
+}
+
+size_t ReverbEngine::getAllocatedBytes() const noexcept
+{
+    return freeverbNetwork.getAllocatedBytes()
+         + fdn8Network.getAllocatedBytes()
+         + fdn16Network.getAllocatedBytes()
+         + (size_t) maxBlock * 2 * sizeof(float);
+}
+
+void ReverbEngine::reset()
+{
+    freeverbNetwork.reset();
+    fdn8Network.reset();
+    fdn16Network.reset();
+
+    crossfadeSamplesLeft = 0;
+    needsClear.fill(false);
+}
+
+void ReverbEngine::setParameters(const juce::Reverb::Parameters& newParams)
+{
+    freeverbNetwork.setParameters(newParams);
+    fdn8Network.setParameters(newParams);
+    fdn16Network.setParameters(newParams);
+}
+
+void ReverbEngine::setMixing(FdnMixing newMixing) noexcept
+{
+    fdn8Network.setMixing(newMixing);
+    fdn16Network.setMixing(newMixing);
+}
+
+void ReverbEngine::setEngine(int newEngine, bool smooth) noexcept
+{
+    newEngine = juce::jlimit(0, numEngines - 1, newEngine);
+
+    if(newEngine == engine)
+        return;
+
+    // A fade still running is cut short; its outgoing network is cleared.
+    if(crossfadeSamplesLeft > 0)
+        needsClear[(size_t) previousEngine] = true;
+
+    previousEngine = engine;
+    engine = newEngine;
+
+    if(smooth && maxBlock > 0)
+    {
+        crossfadeSamplesLeft = crossfadeLength;
+    }
+    else
+    {
+        needsClear[(size_t) previousEngine] = true;
+        crossfadeSamplesLeft = 0;
+    }
+}
+
+void ReverbEngine::clearPending(int numSamples) noexcept
+{
+    const int maxFloats = numSamples * floatsToClearPerSample;
+
+    for(int engineToClear = 0; engineToClear < numEngines; ++engineToClear)
+    {
+        if(! needsClear[(size_t) engineToClear])
+            continue;
+
+        bool cleared = false;
+        switch(engineToClear)
+        {
+            case freeverb: cleared = freeverbNetwork.clearSome(maxFloats); break;
+            case fdn8:     cleared = fdn8Network.clearSome(maxFloats); break;
+            case fdn16:    cleared = fdn16Network.clearSome(maxFloats); break;
+            default:       break;
+        }
+
+        needsClear[(size_t) engineToClear] = ! cleared;
+        return;
+    }
+}
+
+template <int numChannels, typename SampleType>
+void ReverbEngine::processEngine(int engineToUse, SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    switch(engineToUse)
+    {
+        case fdn8:  fdn8Network.process<numChannels>(left, right, numSamples); break;
+        case fdn16: fdn16Network.process<numChannels>(left, right, numSamples); break;
+        default:    freeverbNetwork.process<numChannels>(left, right, numSamples); break;
+    }
+}
+
+template <int numChannels, typename SampleType>
+void ReverbEngine::processOrSilence(int engineToUse, SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    if(! needsClear[(size_t) engineToUse])
+    {
+        processEngine<numChannels>(engineToUse, left, right, numSamples);
+        return;
+    }
+
+    std::fill(left, left + numSamples, SampleType());
+    if constexpr(numChannels > 1)
+        std::fill(right, right + numSamples, SampleType());
+}
+
+template <int numChannels, typename SampleType>
+void ReverbEngine::process(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    clearPending(numSamples);
+
+    // The fade buffers hold maxBlock samples, so a fade runs in pieces.
+    while(crossfadeSamplesLeft > 0 && numSamples > 0)
+    {
+        const int n = juce::jmin(numSamples, maxBlock);
+        processCrossfade<numChannels>(left, right, n);
+
+        left += n;
+        if constexpr(numChannels > 1)
+            right += n;
+        numSamples -= n;
+    }
+
+    if(numSamples > 0)
+        processOrSilence<numChannels>(engine, left, right, numSamples);
+}
+
+template <int numChannels, typename SampleType>
+void ReverbEngine::processCrossfade(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    // The outgoing network runs on a float copy of the input.
+    for(int i = 0; i < numSamples; ++i)
+    {
+        fadeL[i] = static_cast<float>(left[i]);
+        if constexpr(numChannels > 1)
+            fadeR[i] = static_cast<float>(right[i]);
+    }
+
+    processOrSilence<numChannels>(previousEngine, fadeL, fadeR, numSamples);
+    processOrSilence<numChannels>(engine, left, right, numSamples);
+
+    const float step = 1.0f / static_cast<float>(crossfadeLength);
+    const float startFade = 1.0f - static_cast<float>(crossfadeSamplesLeft) * step;
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        const SampleType fade = juce::jmin(1.0f, startFade + static_cast<float>(i + 1) * step);
+
+        left[i] = fadeL[i] + fade * (left[i] - fadeL[i]);
+        if constexpr(numChannels > 1)
+            right[i] = fadeR[i] + fade * (right[i] - fadeR[i]);
+    }
+
+    crossfadeSamplesLeft -= numSamples;
+
+    if(crossfadeSamplesLeft <= 0)
+        needsClear[(size_t) previousEngine] = true;
+}
+
+template void ReverbEngine::process<1>(float*, float*, int) noexcept;
+template void ReverbEngine::process<2>(float*, float*, int) noexcept;
+template void ReverbEngine::process<1>(double*, double*, int) noexcept;
+template void ReverbEngine::process<2>(double*, double*, int) noexcept;
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "StereoReverb.h"
+#include "FdnReverb.h"
+
+// The selectable reverb networks behind one interface. All of them are
+// prepared up front, so switching on the audio thread never allocates. A
+// switch crossfades from the outgoing network, which keeps running on the
+// same input for the length of the fade. Afterwards it is cleared a bounded
+// amount per call, so no single sub-block pays for a whole network. One
+// selected again before it is clear stays silent until it is.
+class ReverbEngine
+{
+public:
+    enum Engine
+    {
+        freeverb = 0,
+        fdn8,
+        fdn16,
+        numEngines
+    };
+
+    static juce::StringArray getEngineNames() {return {"Freeverb", "FDN 8", "FDN 16"};}
+    static juce::StringArray getMixingNames() {return {"Hadamard", "Householder"};}
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    // Every network's delay lines and the crossfade buffers.
+    size_t getAllocatedBytes() const noexcept;
+
+    void setParameters(const juce::Reverb::Parameters& newParams);
+    void setMixing(FdnMixing newMixing) noexcept;
+
+    // Safe to call from the audio thread.
+    void setEngine(int newEngine, bool smooth = true) noexcept;
+    int getEngine() const noexcept {return engine;}
+
+    // Same as StereoReverb::process.
+    template <int numChannels, typename SampleType>
+    void process(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+private:
+    template <int numChannels, typename SampleType>
+    void processCrossfade(SampleType* left, SampleType* right, int numSamples) noexcept;
+    template <int numChannels, typename SampleType>
+    void processEngine(int engineToUse, SampleType* left, SampleType* right, int numSamples) noexcept;
+    template <int numChannels, typename SampleType>
+    void processOrSilence(int engineToUse, SampleType* left, SampleType* right, int numSamples) noexcept;
+    void clearPending(int numSamples) noexcept;
+
+    StereoReverb freeverbNetwork;
+    FdnReverb<8> fdn8Network;
+    FdnReverb<16> fdn16Network;
+
+    int engine = freeverb;
+    int previousEngine = freeverb;
+    int crossfadeLength = 1;
+    int crossfadeSamplesLeft = 0;
+
+    // Networks switched away from that still hold part of their tail.
+    std::array<bool, numEngines> needsClear {};
+    static constexpr int floatsToClearPerSample = 256;
+
+    juce::HeapBlock<float> fadeStorage;
+    float* fadeL = nullptr;
+    float* fadeR = nullptr;
+    int maxBlock = 0;
+};
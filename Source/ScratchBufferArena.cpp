@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    ScratchBufferArena.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ScratchBufferArena.h"
+
+template <typename SampleType>
+void ScratchBufferArena<SampleType>::prepare(int channels, int blockSize)
+{
+    numChannels = juce::jmax(1, channels);
+    maxBlockSize = juce::jmax(1, blockSize);
+
+    for(auto& buffer : buffers)
+    {
+        buffer.setSize(numChannels, maxBlockSize, false, true, false);
+    }
+}
+
+template <typename SampleType>
+void ScratchBufferArena<SampleType>::release()
+{
+    for(auto& buffer : buffers)
+    {
+        buffer.setSize(0, 0);
+    }
+
+    numChannels = 0;
+    maxBlockSize = 0;
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType>& ScratchBufferArena<SampleType>::copyInto(Slot slot, const juce::AudioBuffer<SampleType>& source)
+{
+    jassert(source.getNumChannels() <= numChannels);
+    jassert(source.getNumSamples() <= maxBlockSize);
+
+    auto& buffer = buffers[(size_t) slot];
+    buffer.makeCopyOf(source, true);
+    return buffer;
+}
+
+template class ScratchBufferArena<float>;
+template class ScratchBufferArena<double>;
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    ScratchBufferArena.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Owns every temporary buffer processBlock needs. All memory is reserved in
+// prepare() so the audio thread only ever copies into existing storage.
+template <typename SampleType>
+class ScratchBufferArena
+{
+public:
+    enum Slot
+    {
+        processedDry = 0,
+        wet,
+        numSlots
+    };
+
+    void prepare(int numChannels, int maxBlockSize);
+    void release();
+
+    int getMaxBlockSize() const {return maxBlockSize;}
+    size_t getAllocatedBytes() const noexcept {return (size_t) numSlots * (size_t) (numChannels * maxBlockSize) * sizeof(SampleType);}
+
+    // Copies source into the slot without reallocating. The source must not be
+    // larger than what the arena was prepared for.
+    juce::AudioBuffer<SampleType>& copyInto(Slot slot, const juce::AudioBuffer<SampleType>& source);
+    juce::AudioBuffer<SampleType>& get(Slot slot) {return buffers[(size_t) slot];}
+
+private:
+    std::array<juce::AudioBuffer<SampleType>, numSlots> buffers;
+    int numChannels = 0;
+    int maxBlockSize = 0;
+};
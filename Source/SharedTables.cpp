@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    SharedTables.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SharedTables.h"
+
+SharedTables::SharedTables()
+{
+    for(size_t i = 0; i < tanTable.size(); ++i)
+        tanTable[i] = static_cast<float>(std::tan(juce::MathConstants<double>::pi * maxTanFrequency * (double) i / tanTableSize));
+}
+
+double SharedTables::getReverbDecaySeconds(double sampleRate, int engine, const std::function<double()>& measure)
+{
+    const auto key = std::make_pair(sampleRate, engine);
+
+    {
+        const juce::ScopedLock lock(decayLock);
+        const auto cached = decaySeconds.find(key);
+
+        if(cached != decaySeconds.end())
+            return cached->second;
+    }
+
+    // Measured without the lock, so other instances aren't held up by a
+    // render of up to 30 s of tail. If two measure the same pair at once,
+    // the first result published is the one kept.
+    const double measured = measure();
+
+    const juce::ScopedLock lock(decayLock);
+    return decaySeconds.emplace(key, measured).first->second;
+}
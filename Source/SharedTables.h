@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    SharedTables.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Read-only lookup tables shared by every instance in the process. Hold them
+// through a juce::SharedResourcePointer<SharedTables>: the first instance
+// builds the tables, the rest reuse them and the last one frees them. The
+// tables aren't written after construction, so any number of audio threads
+// can read them at once. The reverb decay cache is the one thing that
+// changes, under a lock and never from an audio thread.
+class SharedTables
+{
+public:
+    SharedTables();
+
+    static constexpr int tanTableSize = 4096;
+    static constexpr float maxTanFrequency = 0.49f;
+
+    // tan(pi x) for a frequency normalised to the sample rate, x = fc / fs,
+    // clamped to 0 to maxTanFrequency. This is the g coefficient of a TPT
+    // state variable filter, so cutoffs can move without calling tan().
+    float tanPi(float x) const noexcept
+    {
+        const float position = juce::jlimit(0.0f, static_cast<float>(tanTableSize), x * tanFrequencyToIndex);
+        const int index = juce::jmin(tanTableSize - 1, static_cast<int>(position));
+        const float fraction = position - static_cast<float>(index);
+
+        return tanTable[(size_t) index] + fraction * (tanTable[(size_t) index + 1] - tanTable[(size_t) index]);
+    }
+
+    // How long each reverb engine rings at a sample rate. The voicing is
+    // fixed, so that is all it depends on. The first instance to ask for a
+    // pair runs measure() and every later one reuses the result. The lock is
+    // only held to look the result up and to publish it.
+    double getReverbDecaySeconds(double sampleRate, int engine, const std::function<double()>& measure);
+
+private:
+    static constexpr float tanFrequencyToIndex = tanTableSize / maxTanFrequency;
+
+    // One guard point past the end so the interpolation never wraps.
+    std::array<float, tanTableSize + 1> tanTable;
+
+    juce::CriticalSection decayLock;
+    std::map<std::pair<double, int>, double> decaySeconds;
+
+    JUCE_DECLARE_NON_COPYABLE(SharedTables)
+};
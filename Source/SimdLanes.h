@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    SimdLanes.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+// Four float lanes on SSE2, NEON or plain arrays, with just the operations
+// the reverb networks need. Loads and stores marked aligned need 16 bytes.
+namespace SimdLanes
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    using Lanes = __m128;
+
+    inline Lanes splat(float v) noexcept                  {return _mm_set1_ps(v);}
+    inline Lanes pairs(float l, float r) noexcept         {return _mm_setr_ps(l, r, l, r);}
+    inline Lanes lanes(float a, float b, float c, float d) noexcept {return _mm_setr_ps(a, b, c, d);}
+    inline Lanes add(Lanes a, Lanes b) noexcept           {return _mm_add_ps(a, b);}
+    inline Lanes sub(Lanes a, Lanes b) noexcept           {return _mm_sub_ps(a, b);}
+    inline Lanes mul(Lanes a, Lanes b) noexcept           {return _mm_mul_ps(a, b);}
+    inline Lanes loadAligned(const float* p) noexcept     {return _mm_load_ps(p);}
+    inline void storeAligned(float* p, Lanes v) noexcept  {_mm_store_ps(p, v);}
+
+    // [a b c d] -> [b a d c] and [c d a b]
+    inline Lanes swapPairs(Lanes v) noexcept              {return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));}
+    inline Lanes swapHalves(Lanes v) noexcept             {return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2));}
+
+    inline Lanes loadTwoPairs(const float* a, const float* b) noexcept
+    {
+        return _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) a), (const __m64*) b);
+    }
+
+    inline void storeTwoPairs(float* a, float* b, Lanes v) noexcept
+    {
+        _mm_storel_pi((__m64*) a, v);
+        _mm_storeh_pi((__m64*) b, v);
+    }
+
+    inline Lanes loadPair(const float* p) noexcept        {return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*) p);}
+    inline void storePair(float* p, Lanes v) noexcept     {_mm_storel_pi((__m64*) p, v);}
+   #elif JUCE_USE_ARM_NEON
+    using Lanes = float32x4_t;
+
+    inline Lanes splat(float v) noexcept                  {return vdupq_n_f32(v);}
+    inline Lanes pairs(float l, float r) noexcept         {const float v[4] {l, r, l, r}; return vld1q_f32(v);}
+    inline Lanes lanes(float a, float b, float c, float d) noexcept {const float v[4] {a, b, c, d}; return vld1q_f32(v);}
+    inline Lanes add(Lanes a, Lanes b) noexcept           {return vaddq_f32(a, b);}
+    inline Lanes sub(Lanes a, Lanes b) noexcept           {return vsubq_f32(a, b);}
+    inline Lanes mul(Lanes a, Lanes b) noexcept           {return vmulq_f32(a, b);}
+    inline Lanes loadAligned(const float* p) noexcept     {return vld1q_f32(p);}
+    inline void storeAligned(float* p, Lanes v) noexcept  {vst1q_f32(p, v);}
+
+    inline Lanes swapPairs(Lanes v) noexcept              {return vrev64q_f32(v);}
+    inline Lanes swapHalves(Lanes v) noexcept             {return vextq_f32(v, v, 2);}
+
+    inline Lanes loadTwoPairs(const float* a, const float* b) noexcept
+    {
+        return vcombine_f32(vld1_f32(a), vld1_f32(b));
+    }
+
+    inline void storeTwoPairs(float* a, float* b, Lanes v) noexcept
+    {
+        vst1_f32(a, vget_low_f32(v));
+        vst1_f32(b, vget_high_f32(v));
+    }
+
+    inline Lanes loadPair(const float* p) noexcept        {return vcombine_f32(vld1_f32(p), vdup_n_f32(0.0f));}
+    inline void storePair(float* p, Lanes v) noexcept     {vst1_f32(p, vget_low_f32(v));}
+   #else
+    struct Lanes { float v[4]; };
+
+    inline Lanes splat(float v) noexcept                  {return {{v, v, v, v}};}
+    inline Lanes pairs(float l, float r) noexcept         {return {{l, r, l, r}};}
+    inline Lanes lanes(float a, float b, float c, float d) noexcept {return {{a, b, c, d}};}
+    inline Lanes add(Lanes a, Lanes b) noexcept           {return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};}
+    inline Lanes sub(Lanes a, Lanes b) noexcept           {return {{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}};}
+    inline Lanes mul(Lanes a, Lanes b) noexcept           {return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};}
+    inline Lanes loadAligned(const float* p) noexcept     {return {{p[0], p[1], p[2], p[3]}};}
+    inline void storeAligned(float* p, Lanes v) noexcept  {std::copy(v.v, v.v + 4, p);}
+
+    inline Lanes swapPairs(Lanes v) noexcept              {return {{v.v[1], v.v[0], v.v[3], v.v[2]}};}
+    inline Lanes swapHalves(Lanes v) noexcept             {return {{v.v[2], v.v[3], v.v[0], v.v[1]}};}
+
+    inline Lanes loadTwoPairs(const float* a, const float* b) noexcept {return {{a[0], a[1], b[0], b[1]}};}
+    inline void storeTwoPairs(float* a, float* b, Lanes v) noexcept    {a[0] = v.v[0]; a[1] = v.v[1]; b[0] = v.v[2]; b[1] = v.v[3];}
+
+    inline Lanes loadPair(const float* p) noexcept        {return {{p[0], p[1], 0.0f, 0.0f}};}
+    inline void storePair(float* p, Lanes v) noexcept     {p[0] = v.v[0]; p[1] = v.v[1];}
+   #endif
+
+    // The sum of all four lanes, in every lane.
+    inline Lanes sumAcross(Lanes v) noexcept
+    {
+        const Lanes t = add(v, swapPairs(v));
+        return add(t, swapHalves(t));
+    }
+}
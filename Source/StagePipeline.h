@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    StagePipeline.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+template <typename SampleType>
+struct StereoFrame
+{
+    SampleType left {};
+    SampleType right {};
+};
+
+// A stage is any type with
+//
+//     template <int numChannels, typename SampleType>
+//     StereoFrame<SampleType> processFrame(StereoFrame<SampleType> frame, int index) noexcept;
+//
+// where index is the frame's position in the current block. processFused()
+// chains the stages at compile time so the whole block is walked once and
+// each frame stays in registers from the first stage to the last.
+//
+// numChannels is 1 or 2. In a mono pipeline only frame.left carries audio,
+// the right channel pointers are ignored (they may be nullptr), and stages
+// leave out their right channel work.
+template <int numChannels, typename SampleType, typename... Stages>
+inline void processFused(const SampleType* inLeft, const SampleType* inRight,
+                         SampleType* outLeft, SampleType* outRight,
+                         int numSamples, Stages&... stages) noexcept
+{
+    static_assert(numChannels == 1 || numChannels == 2, "mono or stereo only");
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        StereoFrame<SampleType> frame;
+        frame.left = inLeft[i];
+        if constexpr(numChannels > 1)
+            frame.right = inRight[i];
+
+        ((frame = stages.template processFrame<numChannels>(frame, i)), ...);
+
+        outLeft[i] = frame.left;
+        if constexpr(numChannels > 1)
+            outRight[i] = frame.right;
+    }
+}
+
+template <int numChannels, typename SampleType, typename... Stages>
+inline void processFusedInPlace(SampleType* left, SampleType* right, int numSamples, Stages&... stages) noexcept
+{
+    processFused<numChannels>(left, right, left, right, numSamples, stages...);
+}
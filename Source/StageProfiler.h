@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "TelemetryFeed.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+// Set to 1 to time every stage of processBlock. With the default of 0 the
+// timing scopes expand to nothing and the profiler isn't part of the
+// processor at all.
+#ifndef VERBMASCHINE_STAGE_TIMING
+ #define VERBMASCHINE_STAGE_TIMING 0
+#endif
+
+// Per stage call counts, totals, maxima and a log2 histogram of the time
+// each call took, in TSC cycles on x86 and nanoseconds elsewhere. Only the
+// audio thread writes; any thread can read while it does.
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        fuzzGate = 0,
+        preDelay,
+        reverb,
+        tailFilter,
+        modulation,
+        mix,
+        tilt,
+        volume,
+        numStages
+    };
+
+    // Bucket b counts calls that took [2^b, 2^(b+1)) ticks.
+    static constexpr int numBuckets = 32;
+
+    static const char* getStageName(int stage) noexcept
+    {
+        static const char* const names[numStages] {"fuzz/gate", "predelay", "reverb", "tail filter",
+                                                   "modulation", "mix", "tilt", "volume"};
+        return juce::isPositiveAndBelow(stage, (int) numStages) ? names[stage] : "";
+    }
+
+    static uint64_t now() noexcept
+    {
+       #if JUCE_INTEL
+        return __rdtsc();
+       #else
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+       #endif
+    }
+
+    static const char* getTickUnit() noexcept
+    {
+       #if JUCE_INTEL
+        return "cycles";
+       #else
+        return "ns";
+       #endif
+    }
+
+    // Audio thread.
+    void add(Stage stage, uint64_t ticks) noexcept
+    {
+        auto& counters = stages[stage];
+        const int bucket = juce::jmin(numBuckets - 1, highestBit(ticks));
+
+        increment(counters.calls, 1);
+        increment(counters.totalTicks, ticks);
+        counters.buckets[bucket].store(counters.buckets[bucket].load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+
+        if(ticks > counters.maxTicks.load(std::memory_order_relaxed))
+            counters.maxTicks.store(ticks, std::memory_order_relaxed);
+    }
+
+    // Times whatever runs in its lifetime as one call of stage.
+    class Scope
+    {
+    public:
+        Scope(StageProfiler& p, Stage s) noexcept : profiler(p), stage(s), start(now()) {}
+        ~Scope() noexcept {profiler.add(stage, now() - start);}
+
+    private:
+        StageProfiler& profiler;
+        Stage stage;
+        uint64_t start;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    struct Summary
+    {
+        uint64_t calls = 0, totalTicks = 0, maxTicks = 0;
+        uint64_t p50Ticks = 0, p99Ticks = 0; // upper edges of their buckets, at most maxTicks
+        uint32_t buckets[numBuckets] {};
+
+        double getMeanTicks() const noexcept {return calls > 0 ? (double) totalTicks / (double) calls : 0.0;}
+    };
+
+    // Any thread. Counters being updated meanwhile may be off by a call.
+    Summary getSummary(Stage stage) const noexcept
+    {
+        const auto& counters = stages[stage];
+        Summary summary;
+        summary.calls = counters.calls.load(std::memory_order_relaxed);
+        summary.totalTicks = counters.totalTicks.load(std::memory_order_relaxed);
+        summary.maxTicks = counters.maxTicks.load(std::memory_order_relaxed);
+
+        uint64_t bucketTotal = 0;
+        for(int b = 0; b < numBuckets; ++b)
+            bucketTotal += (summary.buckets[b] = counters.buckets[b].load(std::memory_order_relaxed));
+
+        uint64_t seen = 0;
+        for(int b = 0; b < numBuckets; ++b)
+        {
+            seen += summary.buckets[b];
+
+            if(summary.p50Ticks == 0 && seen * 2 >= bucketTotal && seen > 0)
+                summary.p50Ticks = juce::jmin(summary.maxTicks, (uint64_t) 1 << (b + 1));
+
+            if(summary.p99Ticks == 0 && seen * 100 >= bucketTotal * 99 && seen > 0)
+                summary.p99Ticks = juce::jmin(summary.maxTicks, (uint64_t) 1 << (b + 1));
+        }
+
+        return summary;
+    }
+
+    // Any thread. Calls counted while it runs may survive the reset.
+    void reset() noexcept
+    {
+        for(auto& counters : stages)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.totalTicks.store(0, std::memory_order_relaxed);
+            counters.maxTicks.store(0, std::memory_order_relaxed);
+
+            for(auto& bucket : counters.buckets)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // One row per stage; the bucket columns are named after their lower edge.
+    juce::String toCsv() const
+    {
+        juce::String csv = "stage,unit,calls,mean,p50,p99,max";
+        for(int b = 0; b < numBuckets; ++b)
+            csv << "," << juce::String((juce::uint64) 1 << b);
+        csv << "\n";
+
+        for(int stage = 0; stage < numStages; ++stage)
+        {
+            const auto summary = getSummary(static_cast<Stage>(stage));
+            csv << getStageName(stage) << "," << getTickUnit() << "," << (juce::int64) summary.calls << ","
+                << summary.getMeanTicks() << "," << (juce::int64) summary.p50Ticks << ","
+                << (juce::int64) summary.p99Ticks << "," << (juce::int64) summary.maxTicks;
+
+            for(auto count : summary.buckets)
+                csv << "," << (int) count;
+            csv << "\n";
+        }
+
+        return csv;
+    }
+
+    juce::var toJson() const
+    {
+        juce::Array<juce::var> stageList;
+
+        for(int stage = 0; stage < numStages; ++stage)
+        {
+            const auto summary = getSummary(static_cast<Stage>(stage));
+            juce::Array<juce::var> histogram;
+            for(auto count : summary.buckets)
+                histogram.add((int) count);
+
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("stage", getStageName(stage));
+            entry->setProperty("calls", (juce::int64) summary.calls);
+            entry->setProperty("mean", summary.getMeanTicks());
+            entry->setProperty("p50", (juce::int64) summary.p50Ticks);
+            entry->setProperty("p99", (juce::int64) summary.p99Ticks);
+            entry->setProperty("max", (juce::int64) summary.maxTicks);
+            entry->setProperty("histogram", histogram);
+            stageList.add(juce::var(entry));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("unit", getTickUnit());
+        root->setProperty("stages", stageList);
+        return juce::var(root);
+    }
+
+private:
+    struct Counters
+    {
+        std::atomic<uint64_t> calls {0}, totalTicks {0}, maxTicks {0};
+        std::atomic<uint32_t> buckets[numBuckets] {};
+    };
+
+    // The audio thread is the only writer, so a plain load and store is
+    // enough and avoids a locked add.
+    static void increment(std::atomic<uint64_t>& counter, uint64_t amount) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static int highestBit(uint64_t value) noexcept
+    {
+        int bit = 0;
+        while(value >>= 1)
+            ++bit;
+        return bit;
+    }
+
+    alignas(cacheLineSize) Counters stages[numStages];
+};
+
+#if VERBMASCHINE_STAGE_TIMING
+ #define VERBMASCHINE_TIME_STAGE(profiler, stage) \
+    StageProfiler::Scope JUCE_JOIN_MACRO(stageScope, __LINE__) ((profiler), StageProfiler::stage)
+#else
+ #define VERBMASCHINE_TIME_STAGE(profiler, stage)
+#endif
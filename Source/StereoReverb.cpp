@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+    StereoReverb.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StereoReverb.h"
+#include "SimdLanes.h"
+
+namespace
+{
+    // Lanes are laid out as [L R L R]: the L/R taps of two comb filters, or
+    // a single L/R pair with the upper half unused.
+    using namespace SimdLanes;
+
+    constexpr int combTunings[StereoReverb::numCombs] = {1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617};
+    constexpr int allPassTunings[StereoReverb::numAllPasses] = {556, 441, 341, 225};
+
+    // Every line starts on its own cache line.
+    constexpr int floatsPerCacheLine = 16;
+
+    int roundUpToCacheLine(int numFloats)
+    {
+        return ((numFloats + floatsPerCacheLine - 1) / floatsPerCacheLine) * floatsPerCacheLine;
+    }
+}
+
+StereoReverb::StereoReverb()
+{
+    static_assert(numCombs % 2 == 0, "combs are processed two at a time");
+
+    updateTargets();
+}
+
+void StereoReverb::prepare(double sampleRate)
+{
+    // Freeverb's tunings are in samples at 44.1 kHz.
+    const int intSampleRate = static_cast<int>(sampleRate);
+    auto scaledLength = [intSampleRate](int tuning)
+    {
+        return juce::jmax(1, (intSampleRate * tuning) / 44100);
+    };
+
+    int totalFloats = floatsPerCacheLine;
+
+    for(int i = 0; i < numCombs; ++i)
+        totalFloats += roundUpToCacheLine(scaledLength(combTunings[i]) * 2);
+
+    for(int i = 0; i < numAllPasses; ++i)
+        totalFloats += roundUpToCacheLine(scaledLength(allPassTunings[i]) * 2);
+
+    storage.calloc(static_cast<size_t>(totalFloats));
+    storageSize = totalFloats;
+    clearPosition = 0;
+    float* next = juce::snapPointerToAlignment(storage.get(), floatsPerCacheLine * sizeof(float));
+
+    auto assignLine = [&next, &scaledLength](Line& line, int tuning)
+    {
+        line.length = scaledLength(tuning);
+        line.index = 0;
+        line.data = next;
+        next += roundUpToCacheLine(line.length * 2);
+    };
+
+    for(int i = 0; i < numCombs; ++i)
+        assignLine(combs[(size_t) i], combTunings[i]);
+
+    for(int i = 0; i < numAllPasses; ++i)
+        assignLine(allPasses[(size_t) i], allPassTunings[i]);
+
+    rampLength = static_cast<int>(std::floor(0.01 * sampleRate));
+
+    updateTargets();
+    reset();
+}
+
+void StereoReverb::reset()
+{
+    for(auto& line : combs)
+    {
+        if(line.data != nullptr)
+            std::fill(line.data, line.data + line.length * 2, 0.0f);
+    }
+
+    for(auto& line : allPasses)
+    {
+        if(line.data != nullptr)
+            std::fill(line.data, line.data + line.length * 2, 0.0f);
+    }
+
+    resetState();
+}
+
+bool StereoReverb::clearSome(int maxFloats) noexcept
+{
+    const int numToClear = juce::jmin(maxFloats, storageSize - clearPosition);
+
+    if(numToClear > 0)
+    {
+        std::fill(storage.get() + clearPosition, storage.get() + clearPosition + numToClear, 0.0f);
+        clearPosition += numToClear;
+    }
+
+    if(clearPosition < storageSize)
+        return false;
+
+    resetState();
+    return true;
+}
+
+void StereoReverb::resetState() noexcept
+{
+    for(auto& line : combs)
+        line.index = 0;
+
+    for(auto& line : allPasses)
+        line.index = 0;
+
+    clearPosition = 0;
+    combLast.fill(0.0f);
+
+    for(auto* ramp : {&damping, &feedback, &wetGain, &dryGain})
+    {
+        ramp->current = ramp->target;
+        ramp->step = 0.0f;
+    }
+
+    rampSamplesLeft = 0;
+}
+
+void StereoReverb::setParameters(const juce::Reverb::Parameters& newParams)
+{
+    if(newParams.roomSize == parameters.roomSize
+       && newParams.damping == parameters.damping
+       && newParams.wetLevel == parameters.wetLevel
+       && newParams.dryLevel == parameters.dryLevel
+       && newParams.width == parameters.width
+       && newParams.freezeMode == parameters.freezeMode)
+        return;
+
+    parameters = newParams;
+    updateTargets();
+
+    if(rampLength <= 0)
+    {
+        reset();
+        return;
+    }
+
+    for(auto* ramp : {&damping, &feedback, &wetGain, &dryGain})
+        ramp->step = (ramp->target - ramp->current) / static_cast<float>(rampLength);
+
+    rampSamplesLeft = rampLength;
+}
+
+void StereoReverb::updateTargets()
+{
+    const bool isFrozen = parameters.freezeMode >= 0.5f;
+
+    wetGain.target = 0.5f * parameters.wetLevel * 3.0f * (1.0f + parameters.width);
+    dryGain.target = parameters.dryLevel * 2.0f;
+    damping.target = isFrozen ? 0.0f : parameters.damping * 0.4f;
+    feedback.target = isFrozen ? 1.0f : parameters.roomSize * 0.28f + 0.7f;
+    inputGain = isFrozen ? 0.0f : 0.015f;
+}
+
+template <int numChannels, typename SampleType>
+void StereoReverb::process(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    jassert(combs[0].data != nullptr); // prepare() first
+
+    while(numSamples > 0)
+    {
+        const bool isRamping = rampSamplesLeft > 0;
+        const int segment = isRamping ? juce::jmin(numSamples, rampSamplesLeft) : numSamples;
+
+        processSegment<numChannels>(left, right, segment, isRamping);
+
+        if(isRamping)
+        {
+            rampSamplesLeft -= segment;
+
+            if(rampSamplesLeft == 0)
+            {
+                for(auto* ramp : {&damping, &feedback, &wetGain, &dryGain})
+                {
+                    ramp->current = ramp->target;
+                    ramp->step = 0.0f;
+                }
+            }
+        }
+
+        left += segment;
+        if constexpr(numChannels > 1)
+            right += segment;
+        numSamples -= segment;
+    }
+}
+
+template <int numChannels, typename SampleType>
+void StereoReverb::processSegment(SampleType* left, SampleType* right, int numSamples, bool isRamping) noexcept
+{
+    float damp = damping.current;
+    float fb = feedback.current;
+    float wet = wetGain.current;
+    float dry = dryGain.current;
+
+    Lanes last[numCombs / 2];
+    for(int j = 0; j < numCombs / 2; ++j)
+        last[j] = loadAligned(combLast.data() + j * 4);
+
+    const Lanes allPassFeedback = splat(0.5f);
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        if(isRamping)
+        {
+            damp += damping.step;
+            fb += feedback.step;
+            wet += wetGain.step;
+            dry += dryGain.step;
+        }
+
+        const SampleType inL = left[i];
+        SampleType inR = inL;
+        if constexpr(numChannels > 1)
+            inR = right[i];
+
+        const Lanes input = pairs(static_cast<float>(inL) * inputGain, static_cast<float>(inR) * inputGain);
+        const Lanes dampLanes = splat(damp);
+        const Lanes undampLanes = splat(1.0f - damp);
+        const Lanes feedbackLanes = splat(fb);
+
+        // === Parallel combs, two per register === //
+        Lanes sum = splat(0.0f);
+
+        for(int j = 0; j < numCombs / 2; ++j)
+        {
+            auto& a = combs[(size_t) (j * 2)];
+            auto& b = combs[(size_t) (j * 2 + 1)];
+            float* tapA = a.data + a.index * 2;
+            float* tapB = b.data + b.index * 2;
+
+            const Lanes out = loadTwoPairs(tapA, tapB);
+            last[j] = add(mul(out, undampLanes), mul(last[j], dampLanes));
+            storeTwoPairs(tapA, tapB, add(input, mul(last[j], feedbackLanes)));
+            sum = add(sum, out);
+
+            if(++a.index >= a.length) a.index = 0;
+            if(++b.index >= b.length) b.index = 0;
+        }
+
+        alignas(16) float combOut[4];
+        storeAligned(combOut, sum);
+
+        // === Serial allpasses on one L/R pair === //
+        Lanes signal = pairs(combOut[0] + combOut[2], combOut[1] + combOut[3]);
+
+        for(auto& line : allPasses)
+        {
+            float* tap = line.data + line.index * 2;
+
+            const Lanes buffered = loadPair(tap);
+            storePair(tap, add(signal, mul(buffered, allPassFeedback)));
+            signal = sub(buffered, signal);
+
+            if(++line.index >= line.length) line.index = 0;
+        }
+
+        alignas(16) float outPair[4];
+        storeAligned(outPair, signal);
+
+        left[i] = static_cast<SampleType>(outPair[0] * wet) + inL * dry;
+        if constexpr(numChannels > 1)
+            right[i] = static_cast<SampleType>(outPair[1] * wet) + inR * dry;
+    }
+
+    for(int j = 0; j < numCombs / 2; ++j)
+        storeAligned(combLast.data() + j * 4, last[j]);
+
+    damping.current = damp;
+    feedback.current = fb;
+    wetGain.current = wet;
+    dryGain.current = dry;
+}
+
+template void StereoReverb::process<1>(float*, float*, int) noexcept;
+template void StereoReverb::process<2>(float*, float*, int) noexcept;
+template void StereoReverb::process<1>(double*, double*, int) noexcept;
+template void StereoReverb::process<2>(double*, double*, int) noexcept;
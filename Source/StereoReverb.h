@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    StereoReverb.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Freeverb network that runs both channels in lockstep. It replaces the pair
+// of juce::Reverb instances that were each driven through processMono, so
+// both channels share the same comb/allpass tunings, and the left/right taps
+// of every line sit next to each other in memory. That lets one SIMD register
+// carry the L/R taps of two comb filters at a time.
+class StereoReverb
+{
+public:
+    StereoReverb();
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // reset() spread over several calls, for the audio thread: clears up to
+    // maxFloats more of the delay memory and returns true once all of it is
+    // clear and the rest of the state reset.
+    bool clearSome(int maxFloats) noexcept;
+
+    // Of the delay lines, which scale with the sample rate.
+    size_t getAllocatedBytes() const noexcept {return (size_t) storageSize * sizeof(float);}
+
+    // Same meaning as juce::Reverb, with the mono wet gain (width only scales
+    // the wet level, there is no cross-feed).
+    void setParameters(const juce::Reverb::Parameters& newParams);
+    const juce::Reverb::Parameters& getParameters() const {return parameters;}
+
+    // numChannels is 1 or 2; a mono block ignores right, which may be
+    // nullptr. The left input then feeds both lanes, which cost the same as
+    // one. Double audio is converted at the input and output of the network,
+    // which always runs in float.
+    template <int numChannels, typename SampleType>
+    void process(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    static constexpr int numCombs = 8;
+    static constexpr int numAllPasses = 4;
+
+private:
+    struct Line
+    {
+        float* data = nullptr; // interleaved L/R pairs
+        int length = 0;
+        int index = 0;
+    };
+
+    struct Ramp
+    {
+        float current = 0.0f, target = 0.0f, step = 0.0f;
+    };
+
+    void updateTargets();
+    void resetState() noexcept;
+    template <int numChannels, typename SampleType>
+    void processSegment(SampleType* left, SampleType* right, int numSamples, bool isRamping) noexcept;
+
+    juce::Reverb::Parameters parameters;
+    juce::HeapBlock<float> storage;
+    int storageSize = 0;
+    int clearPosition = 0;
+    std::array<Line, numCombs> combs;
+    std::array<Line, numAllPasses> allPasses;
+    alignas(16) std::array<float, numCombs * 2> combLast {}; // one-pole state, L/R per comb
+
+    Ramp damping, feedback, wetGain, dryGain;
+    float inputGain = 0.015f;
+    int rampLength = 441;
+    int rampSamplesLeft = 0;
+};
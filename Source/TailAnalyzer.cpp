@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    TailAnalyzer.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TailAnalyzer.h"
+
+namespace
+{
+    // Analysis time allowed per display frame, for all three streams.
+    constexpr double budgetMs = 1.0;
+    constexpr int runsBeforeAdapting = 30;
+
+    constexpr float peakHoldSeconds = 1.0f;
+    constexpr float peakFallDecibelsPerSecond = 24.0f;
+    constexpr float spectrumFallDecibelsPerSecond = 60.0f;
+}
+
+TailAnalyzer::TailAnalyzer(AnalyzerFeed& feedToRead)
+    : feed(feedToRead)
+{
+    for(auto& state : streams)
+        state.history.assign((size_t) 1 << maxFftOrder, 0.0f);
+
+    readBuffer.resize(4096);
+    setFftOrder(fftOrder);
+    reset();
+}
+
+void TailAnalyzer::reset()
+{
+    for(auto& state : streams)
+    {
+        std::fill(state.history.begin(), state.history.end(), 0.0f);
+        state.historyWrite = 0;
+
+        std::fill(std::begin(state.columnMin), std::end(state.columnMin), 0.0f);
+        std::fill(std::begin(state.columnMax), std::end(state.columnMax), 0.0f);
+        state.pendingMin = state.pendingMax = 0.0f;
+        state.pendingCount = 0;
+        state.nextColumn = 0;
+
+        std::fill(std::begin(state.spectrum), std::end(state.spectrum), floorDecibels);
+        std::fill(std::begin(state.peaks), std::end(state.peaks), floorDecibels);
+        std::fill(std::begin(state.peakAge), std::end(state.peakAge), 0.0f);
+    }
+
+    framesUntilUpdate = 0;
+}
+
+void TailAnalyzer::setFftOrder(int newOrder)
+{
+    fftOrder = juce::jlimit(minFftOrder, maxFftOrder, newOrder);
+
+    const int fftSize = 1 << fftOrder;
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    window = std::make_unique<juce::dsp::WindowingFunction<float>>((size_t) fftSize,
+                                                                   juce::dsp::WindowingFunction<float>::hann,
+                                                                   false);
+    fftData.assign((size_t) fftSize * 2, 0.0f);
+}
+
+bool TailAnalyzer::update(double sampleRate, float seconds)
+{
+    if(sampleRate <= 0.0)
+        return false;
+
+    if(sampleRate != currentSampleRate)
+    {
+        currentSampleRate = sampleRate;
+        reset();
+    }
+
+    const int samplesPerColumn = juce::jmax(1, juce::roundToInt(sampleRate * waveformSeconds / numColumns));
+    bool changed = false;
+
+    for(int stream = 0; stream < AnalyzerFeed::numStreams; ++stream)
+    {
+        for(;;)
+        {
+            const int numRead = feed.read(static_cast<AnalyzerFeed::Stream>(stream),
+                                          readBuffer.data(), (int) readBuffer.size());
+            if(numRead == 0)
+                break;
+
+            if(addSamples(streams[stream], readBuffer.data(), numRead, samplesPerColumn) > 0)
+                changed = true;
+        }
+    }
+
+    if(--framesUntilUpdate > 0)
+        return changed;
+
+    framesUntilUpdate = updateInterval;
+
+    const double start = juce::Time::getMillisecondCounterHiRes();
+
+    for(auto& state : streams)
+        analyse(state, seconds * static_cast<float>(updateInterval));
+
+    adaptToCost(juce::Time::getMillisecondCounterHiRes() - start);
+    return true;
+}
+
+int TailAnalyzer::addSamples(StreamState& state, const float* samples, int numSamples, int samplesPerColumn)
+{
+    const int historySize = (int) state.history.size();
+    int columnsAdded = 0;
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        const float sample = samples[i];
+
+        state.history[(size_t) state.historyWrite] = sample;
+        state.historyWrite = (state.historyWrite + 1) & (historySize - 1);
+
+        if(state.pendingCount == 0)
+        {
+            state.pendingMin = state.pendingMax = sample;
+        }
+        else
+        {
+            state.pendingMin = juce::jmin(state.pendingMin, sample);
+            state.pendingMax = juce::jmax(state.pendingMax, sample);
+        }
+
+        if(++state.pendingCount >= samplesPerColumn)
+        {
+            addColumn(state, state.pendingMin, state.pendingMax);
+            ++columnsAdded;
+        }
+    }
+
+    return columnsAdded;
+}
+
+void TailAnalyzer::addColumn(StreamState& state, float minimum, float maximum)
+{
+    state.columnMin[state.nextColumn] = minimum;
+    state.columnMax[state.nextColumn] = maximum;
+    state.pendingCount = 0;
+    state.nextColumn = (state.nextColumn + 1) % numColumns;
+}
+
+void TailAnalyzer::analyse(StreamState& state, float seconds)
+{
+    const int fftSize = 1 << fftOrder;
+    const int historySize = (int) state.history.size();
+
+    // The latest fftSize samples, oldest first.
+    for(int i = 0; i < fftSize; ++i)
+        fftData[(size_t) i] = state.history[(size_t) ((state.historyWrite - fftSize + i) & (historySize - 1))];
+
+    window->multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full scale sine reads 0 dB: a Hann window halves the amplitude, and
+    // the transform sums fftSize / 2 of it into each of the two mirror bins.
+    const float scale = 4.0f / static_cast<float>(fftSize);
+    const float binsPerHz = static_cast<float>(fftSize) / static_cast<float>(currentSampleRate);
+    const int lastBin = fftSize / 2;
+
+    const float peakFall = peakFallDecibelsPerSecond * seconds;
+    const float spectrumFall = spectrumFallDecibelsPerSecond * seconds;
+
+    for(int band = 0; band < numBands; ++band)
+    {
+        const float lowBin = getBandFrequency(static_cast<float>(band)) * binsPerHz;
+        const float highBin = getBandFrequency(static_cast<float>(band + 1)) * binsPerHz;
+
+        // Bands narrower than a bin read the nearest one; wider ones take the
+        // loudest bin they cover.
+        const int first = juce::jlimit(0, lastBin, juce::roundToInt(lowBin));
+        const int last = juce::jlimit(first, lastBin, juce::roundToInt(highBin) - 1);
+
+        float magnitude = 0.0f;
+        for(int bin = first; bin <= last; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t) bin]);
+
+        const float level = juce::jmax(floorDecibels, juce::Decibels::gainToDecibels(magnitude * scale, floorDecibels));
+
+        state.spectrum[band] = juce::jmax(level, state.spectrum[band] - spectrumFall);
+
+        if(level >= state.peaks[band])
+        {
+            state.peaks[band] = level;
+            state.peakAge[band] = 0.0f;
+        }
+        else if((state.peakAge[band] += seconds) > peakHoldSeconds)
+        {
+            state.peaks[band] = juce::jmax(level, state.peaks[band] - peakFall);
+        }
+    }
+}
+
+void TailAnalyzer::adaptToCost(double costMs)
+{
+    averageCostMs = averageCostMs > 0.0 ? 0.9 * averageCostMs + 0.1 * costMs : costMs;
+
+    // Per display frame, the cost is spread over updateInterval frames.
+    const double costPerFrame = averageCostMs / updateInterval;
+
+    expensiveRuns = costPerFrame > budgetMs ? expensiveRuns + 1 : 0;
+    cheapRuns = costPerFrame < budgetMs * 0.25 ? cheapRuns + 1 : 0;
+
+    if(expensiveRuns >= runsBeforeAdapting)
+    {
+        // Update less often first; the resolution is what you tune by.
+        if(updateInterval < maxUpdateInterval)
+            ++updateInterval;
+        else if(fftOrder > minFftOrder)
+            setFftOrder(fftOrder - 1);
+
+        expensiveRuns = 0;
+    }
+    else if(cheapRuns >= runsBeforeAdapting)
+    {
+        if(fftOrder < maxFftOrder)
+        {
+            setFftOrder(fftOrder + 1);
+            averageCostMs *= 2.0;
+        }
+        else if(updateInterval > 1)
+        {
+            --updateInterval;
+        }
+
+        cheapRuns = 0;
+    }
+}
+
+float TailAnalyzer::getBandFrequency(float band) const noexcept
+{
+    const float nyquist = static_cast<float>(juce::jmax(1.0, currentSampleRate) * 0.5);
+    return lowestFrequency * std::pow(nyquist / lowestFrequency, band / static_cast<float>(numBands));
+}
+
+float TailAnalyzer::getColumnMin(AnalyzerFeed::Stream stream, int column) const noexcept
+{
+    return streams[stream].columnMin[(streams[stream].nextColumn + column) % numColumns];
+}
+
+float TailAnalyzer::getColumnMax(AnalyzerFeed::Stream stream, int column) const noexcept
+{
+    return streams[stream].columnMax[(streams[stream].nextColumn + column) % numColumns];
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    TailAnalyzer.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "AnalyzerFeed.h"
+
+// Turns what AnalyzerFeed collects into log-frequency spectra with peak hold
+// and a scrolling min / max waveform per stream. Runs on the message thread.
+// The FFT size and how often it runs adapt to what the machine can spare.
+class TailAnalyzer
+{
+public:
+    static constexpr int numBands = 64;
+    static constexpr int numColumns = 256;
+    static constexpr double waveformSeconds = 4.0;
+    static constexpr float lowestFrequency = 20.0f;
+    static constexpr float floorDecibels = -96.0f;
+
+    static constexpr int minFftOrder = 10;
+    static constexpr int maxFftOrder = 13;
+    static constexpr int maxUpdateInterval = 4;
+
+    explicit TailAnalyzer(AnalyzerFeed& feedToRead);
+
+    void reset();
+
+    // Drains the feed and, when due, runs a new analysis. Returns true when
+    // there is something new to show.
+    bool update(double sampleRate, float seconds);
+
+    // dB per band, from lowestFrequency to Nyquist.
+    const float* getSpectrum(AnalyzerFeed::Stream stream) const noexcept {return streams[stream].spectrum;}
+    const float* getPeaks(AnalyzerFeed::Stream stream) const noexcept   {return streams[stream].peaks;}
+    float getBandFrequency(float band) const noexcept;
+
+    // Waveform columns, oldest first.
+    float getColumnMin(AnalyzerFeed::Stream stream, int column) const noexcept;
+    float getColumnMax(AnalyzerFeed::Stream stream, int column) const noexcept;
+
+    int getFftOrder() const noexcept       {return fftOrder;}
+    int getUpdateInterval() const noexcept {return updateInterval;}
+
+private:
+    struct StreamState
+    {
+        std::vector<float> history;
+        int historyWrite = 0;
+
+        float columnMin[numColumns] {}, columnMax[numColumns] {};
+        float pendingMin = 0.0f, pendingMax = 0.0f;
+        int pendingCount = 0;
+        int nextColumn = 0;
+
+        float spectrum[numBands] {}, peaks[numBands] {};
+        float peakAge[numBands] {};
+    };
+
+    AnalyzerFeed& feed;
+    StreamState streams[AnalyzerFeed::numStreams];
+    double currentSampleRate = 0.0;
+
+    int fftOrder = 11;
+    int updateInterval = 2;
+    int framesUntilUpdate = 0;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::vector<float> fftData;
+    std::vector<float> readBuffer;
+
+    // Smoothed cost of one analysis, and how many in a row were well under
+    // or over budget.
+    double averageCostMs = 0.0;
+    int cheapRuns = 0, expensiveRuns = 0;
+
+    void setFftOrder(int newOrder);
+    int addSamples(StreamState& state, const float* samples, int numSamples, int samplesPerColumn);
+    void addColumn(StreamState& state, float minimum, float maximum);
+    void analyse(StreamState& state, float seconds);
+    void adaptToCost(double costMs);
+
+    JUCE_DECLARE_NON_COPYABLE(TailAnalyzer)
+};
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    TelemetryFeed.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// Typical cache line size on the x86 and ARM machines plugins run on.
+static constexpr size_t cacheLineSize = 64;
+
+// What the editor sees of one processBlock call. Levels are linear gain, the
+// left channel's copied to the right for mono layouts.
+struct alignas(cacheLineSize) TelemetryRecord
+{
+    static constexpr int waveformPoints = 8;
+
+    float inputPeak[2] {}, inputRms[2] {};
+    float outputPeak[2] {}, outputRms[2] {};
+
+    // The wet tail envelope scaled by VERB, and the gain the gate after the
+    // fuzz applied at the end of the block, 1 when open.
+    float tailLevel[2] {};
+    float gateGain[2] {1.0f, 1.0f};
+
+    // The output summed to mono, as the lowest and highest sample in each of
+    // waveformPoints equal slices of the block.
+    float waveformMin[waveformPoints] {}, waveformMax[waveformPoints] {};
+
+    int numSamples = 0;
+};
+
+// Lock-free ring for one producer thread and one consumer thread. Each index
+// sits on its own cache line next to the producer's or consumer's cached copy
+// of the other one, so neither side writes a line the other keeps reading.
+template <typename Record, int capacity>
+class SpscRing
+{
+public:
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+    // Producer only. Returns false, dropping the record, when the consumer
+    // has fallen a whole ring behind.
+    bool push(const Record& record) noexcept
+    {
+        const auto write = writeIndex.load(std::memory_order_relaxed);
+
+        if(write - cachedReadIndex == (uint32_t) capacity)
+        {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+
+            if(write - cachedReadIndex == (uint32_t) capacity)
+                return false;
+        }
+
+        slots[write & mask] = record;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Returns false when there is nothing to read.
+    bool pop(Record& record) noexcept
+    {
+        const auto read = readIndex.load(std::memory_order_relaxed);
+
+        if(read == cachedWriteIndex)
+        {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+
+            if(read == cachedWriteIndex)
+                return false;
+        }
+
+        record = slots[read & mask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    void discardAll() noexcept
+    {
+        readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t mask = (uint32_t) capacity - 1;
+
+    alignas(cacheLineSize) std::atomic<uint32_t> writeIndex {0};
+    uint32_t cachedReadIndex = 0;
+
+    alignas(cacheLineSize) std::atomic<uint32_t> readIndex {0};
+    uint32_t cachedWriteIndex = 0;
+
+    alignas(cacheLineSize) std::array<Record, capacity> slots {};
+};
+
+// Gathers one TelemetryRecord over a processBlock call, which the processor
+// may work through in several chunks. Audio thread only.
+class TelemetryBuilder
+{
+public:
+    void begin(int totalNumSamples) noexcept
+    {
+        record = {};
+        blockLength = juce::jmax(1, totalNumSamples);
+        position = 0;
+        inputSquares[0] = inputSquares[1] = 0.0;
+        outputSquares[0] = outputSquares[1] = 0.0;
+
+        for(int i = 0; i < TelemetryRecord::waveformPoints; ++i)
+        {
+            record.waveformMin[i] = std::numeric_limits<float>::max();
+            record.waveformMax[i] = std::numeric_limits<float>::lowest();
+        }
+    }
+
+    // Call before the chunk is processed in place.
+    template <typename SampleType>
+    void addInput(const juce::AudioBuffer<SampleType>& chunk, int numChannels) noexcept
+    {
+        for(int channel = 0; channel < numChannels; ++channel)
+            accumulate(chunk.getReadPointer(channel), chunk.getNumSamples(),
+                       record.inputPeak[channel], inputSquares[channel]);
+    }
+
+    // Call once per chunk, after it's processed, in order.
+    template <typename SampleType>
+    void addOutput(const juce::AudioBuffer<SampleType>& chunk, int numChannels) noexcept
+    {
+        const int numSamples = chunk.getNumSamples();
+
+        for(int channel = 0; channel < numChannels; ++channel)
+            accumulate(chunk.getReadPointer(channel), numSamples, record.outputPeak[channel], outputSquares[channel]);
+
+        const SampleType* left = chunk.getReadPointer(0);
+        const SampleType* right = chunk.getReadPointer(numChannels > 1 ? 1 : 0);
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            const auto point = (int) ((int64_t) (position + i) * TelemetryRecord::waveformPoints / blockLength);
+            const float mono = static_cast<float>(left[i] + right[i]) * 0.5f;
+
+            record.waveformMin[point] = juce::jmin(record.waveformMin[point], mono);
+            record.waveformMax[point] = juce::jmax(record.waveformMax[point], mono);
+        }
+
+        position += numSamples;
+    }
+
+    // A chunk that wasn't processed and came out silent.
+    void addSilence(int numSamples) noexcept
+    {
+        for(int i = 0; i < numSamples; ++i)
+        {
+            const auto point = (int) ((int64_t) (position + i) * TelemetryRecord::waveformPoints / blockLength);
+            record.waveformMin[point] = juce::jmin(record.waveformMin[point], 0.0f);
+            record.waveformMax[point] = juce::jmax(record.waveformMax[point], 0.0f);
+        }
+
+        position += numSamples;
+    }
+
+    void setTail(float left, float right) noexcept {record.tailLevel[0] = left; record.tailLevel[1] = right;}
+    void setGate(float left, float right) noexcept {record.gateGain[0] = left; record.gateGain[1] = right;}
+
+    const TelemetryRecord& finish(int numChannels) noexcept
+    {
+        const double length = static_cast<double>(juce::jmax(1, position));
+
+        for(int channel = 0; channel < 2; ++channel)
+        {
+            record.inputRms[channel] = static_cast<float>(std::sqrt(inputSquares[channel] / length));
+            record.outputRms[channel] = static_cast<float>(std::sqrt(outputSquares[channel] / length));
+        }
+
+        if(numChannels < 2)
+        {
+            record.inputPeak[1] = record.inputPeak[0];
+            record.inputRms[1] = record.inputRms[0];
+            record.outputPeak[1] = record.outputPeak[0];
+            record.outputRms[1] = record.outputRms[0];
+            record.tailLevel[1] = record.tailLevel[0];
+            record.gateGain[1] = record.gateGain[0];
+        }
+
+        // Slices past the end of a block shorter than waveformPoints.
+        for(int i = 0; i < TelemetryRecord::waveformPoints; ++i)
+        {
+            if(record.waveformMin[i] > record.waveformMax[i])
+                record.waveformMin[i] = record.waveformMax[i] = 0.0f;
+        }
+
+        record.numSamples = position;
+        return record;
+    }
+
+private:
+    template <typename SampleType>
+    static void accumulate(const SampleType* data, int numSamples, float& peak, double& squares) noexcept
+    {
+        SampleType blockPeak = 0;
+        SampleType sum = 0;
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            blockPeak = juce::jmax(blockPeak, std::abs(data[i]));
+            sum += data[i] * data[i];
+        }
+
+        peak = juce::jmax(peak, static_cast<float>(blockPeak));
+        squares += static_cast<double>(sum);
+    }
+
+    TelemetryRecord record;
+    double inputSquares[2] {}, outputSquares[2] {};
+    int blockLength = 1;
+    int position = 0;
+};
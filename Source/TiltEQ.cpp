@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    TiltEQ.cpp
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TiltEQ.h"
+#include "FastMath.h"
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace
+{
+    // One L/R pair per register. The float SSE version leaves the upper two
+    // lanes unused.
+    template <typename T>
+    struct ScalarPair
+    {
+        struct Reg { T l, r; };
+
+        static Reg splat(T v) noexcept               {return {v, v};}
+        static Reg load(T l, T r) noexcept           {return {l, r};}
+        static Reg add(Reg a, Reg b) noexcept        {return {a.l + b.l, a.r + b.r};}
+        static Reg sub(Reg a, Reg b) noexcept        {return {a.l - b.l, a.r - b.r};}
+        static Reg mul(Reg a, Reg b) noexcept        {return {a.l * b.l, a.r * b.r};}
+        static Reg loadState(const T* p) noexcept    {return {p[0], p[1]};}
+        static void storeState(T* p, Reg v) noexcept {p[0] = v.l; p[1] = v.r;}
+        static T left(Reg v) noexcept                {return v.l;}
+        static T right(Reg v) noexcept               {return v.r;}
+    };
+
+   #if JUCE_USE_SSE_INTRINSICS
+    struct FloatPair
+    {
+        using Reg = __m128;
+
+        static Reg splat(float v) noexcept               {return _mm_set1_ps(v);}
+        static Reg load(float l, float r) noexcept       {return _mm_unpacklo_ps(_mm_set_ss(l), _mm_set_ss(r));}
+        static Reg add(Reg a, Reg b) noexcept            {return _mm_add_ps(a, b);}
+        static Reg sub(Reg a, Reg b) noexcept            {return _mm_sub_ps(a, b);}
+        static Reg mul(Reg a, Reg b) noexcept            {return _mm_mul_ps(a, b);}
+        static Reg loadState(const float* p) noexcept    {return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*) p);}
+        static void storeState(float* p, Reg v) noexcept {_mm_storel_pi((__m64*) p, v);}
+        static float left(Reg v) noexcept                {return _mm_cvtss_f32(v);}
+        static float right(Reg v) noexcept               {return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));}
+    };
+
+    struct DoublePair
+    {
+        using Reg = __m128d;
+
+        static Reg splat(double v) noexcept               {return _mm_set1_pd(v);}
+        static Reg load(double l, double r) noexcept      {return _mm_setr_pd(l, r);}
+        static Reg add(Reg a, Reg b) noexcept             {return _mm_add_pd(a, b);}
+        static Reg sub(Reg a, Reg b) noexcept             {return _mm_sub_pd(a, b);}
+        static Reg mul(Reg a, Reg b) noexcept             {return _mm_mul_pd(a, b);}
+        static Reg loadState(const double* p) noexcept    {return _mm_loadu_pd(p);}
+        static void storeState(double* p, Reg v) noexcept {_mm_storeu_pd(p, v);}
+        static double left(Reg v) noexcept                {return _mm_cvtsd_f64(v);}
+        static double right(Reg v) noexcept               {return _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));}
+    };
+   #elif JUCE_USE_ARM_NEON
+    struct FloatPair
+    {
+        using Reg = float32x2_t;
+
+        static Reg splat(float v) noexcept               {return vdup_n_f32(v);}
+        static Reg load(float l, float r) noexcept       {return vset_lane_f32(r, vdup_n_f32(l), 1);}
+        static Reg add(Reg a, Reg b) noexcept            {return vadd_f32(a, b);}
+        static Reg sub(Reg a, Reg b) noexcept            {return vsub_f32(a, b);}
+        static Reg mul(Reg a, Reg b) noexcept            {return vmul_f32(a, b);}
+        static Reg loadState(const float* p) noexcept    {return vld1_f32(p);}
+        static void storeState(float* p, Reg v) noexcept {vst1_f32(p, v);}
+        static float left(Reg v) noexcept                {return vget_lane_f32(v, 0);}
+        static float right(Reg v) noexcept               {return vget_lane_f32(v, 1);}
+    };
+
+    #if JUCE_64BIT
+    struct DoublePair
+    {
+        using Reg = float64x2_t;
+
+        static Reg splat(double v) noexcept               {return vdupq_n_f64(v);}
+        static Reg load(double l, double r) noexcept      {return vsetq_lane_f64(r, vdupq_n_f64(l), 1);}
+        static Reg add(Reg a, Reg b) noexcept             {return vaddq_f64(a, b);}
+        static Reg sub(Reg a, Reg b) noexcept             {return vsubq_f64(a, b);}
+        static Reg mul(Reg a, Reg b) noexcept             {return vmulq_f64(a, b);}
+        static Reg loadState(const double* p) noexcept    {return vld1q_f64(p);}
+        static void storeState(double* p, Reg v) noexcept {vst1q_f64(p, v);}
+        static double left(Reg v) noexcept                {return vgetq_lane_f64(v, 0);}
+        static double right(Reg v) noexcept               {return vgetq_lane_f64(v, 1);}
+    };
+    #else
+    using DoublePair = ScalarPair<double>;
+    #endif
+   #else
+    using FloatPair = ScalarPair<float>;
+    using DoublePair = ScalarPair<double>;
+   #endif
+
+    template <typename T> struct PairFor;
+    template <> struct PairFor<float>  { using Type = FloatPair; };
+    template <> struct PairFor<double> { using Type = DoublePair; };
+
+    constexpr double rampSeconds = 0.02;
+}
+
+template <typename StateType>
+void TiltEQ<StateType>::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    rampSteps = juce::jmax(1, juce::roundToInt(rampSeconds * sampleRate / controlInterval));
+
+    updateTarget();
+    current = target;
+    stepsLeft = 0;
+
+    reset();
+}
+
+template <typename StateType>
+void TiltEQ<StateType>::reset()
+{
+    state.fill(StateType());
+    samplesUntilUpdate = 0;
+}
+
+template <typename StateType>
+void TiltEQ<StateType>::setTilt(float darkLight, bool smooth) noexcept
+{
+    if(darkLight == tilt && smooth)
+        return;
+
+    tilt = darkLight;
+    updateTarget();
+
+    if(! smooth)
+    {
+        current = target;
+        stepsLeft = 0;
+        return;
+    }
+
+    const auto steps = static_cast<StateType>(rampSteps);
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+        for(size_t i = 0; i < 5; ++i)
+            increment[stage][i] = (target[stage][i] - current[stage][i]) / steps;
+
+    stepsLeft = rampSteps;
+}
+
+template <typename StateType>
+void TiltEQ<StateType>::updateTarget() noexcept
+{
+    float shapedTilt = juce::jlimit(-1.0f, 1.0f, tilt);
+    shapedTilt = FastMath::tanh(shapedTilt * 2.0f);
+    shapedTilt = -shapedTilt;
+
+    float lowGainDb = shapedTilt * 2.0f;
+    float freq = 800.0f;
+    float q = 0.707f;
+
+    // Same design and normalisation as IIR::Coefficients::makeLowShelf, minus
+    // the allocation.
+    const auto lowShelf = juce::dsp::IIR::ArrayCoefficients<StateType>::makeLowShelf(
+        sampleRate, static_cast<StateType>(freq), static_cast<StateType>(q),
+        static_cast<StateType>(juce::Decibels::decibelsToGain(lowGainDb)));
+
+    const StateType a0Inv = lowShelf[3] != StateType() ? static_cast<StateType>(1) / lowShelf[3] : StateType();
+    const Coefficients normalised {lowShelf[0] * a0Inv, lowShelf[1] * a0Inv, lowShelf[2] * a0Inv,
+                                   lowShelf[4] * a0Inv, lowShelf[5] * a0Inv};
+
+    // Both stages run the low shelf; that is the tilt the plugin has always
+    // shipped with.
+    target.fill(normalised);
+}
+
+template <typename StateType>
+void TiltEQ<StateType>::advanceRamp() noexcept
+{
+    if(stepsLeft <= 0)
+        return;
+
+    if(--stepsLeft == 0)
+    {
+        current = target;
+        return;
+    }
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+        for(size_t i = 0; i < 5; ++i)
+            current[stage][i] += increment[stage][i];
+}
+
+template <typename StateType>
+template <int numChannels, typename SampleType>
+void TiltEQ<StateType>::process(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    int done = 0;
+
+    while(done < numSamples)
+    {
+        if(samplesUntilUpdate <= 0)
+        {
+            advanceRamp();
+            samplesUntilUpdate = controlInterval;
+        }
+
+        const int runLength = juce::jmin(numSamples - done, samplesUntilUpdate);
+        processRun<numChannels>(left + done, numChannels > 1 ? right + done : nullptr, runLength);
+
+        done += runLength;
+        samplesUntilUpdate -= runLength;
+    }
+}
+
+template <typename StateType>
+template <int numChannels, typename SampleType>
+void TiltEQ<StateType>::processRun(SampleType* left, SampleType* right, int numSamples) noexcept
+{
+    using Pair = typename PairFor<StateType>::Type;
+    using Reg = typename Pair::Reg;
+
+    Reg b0[numStages], b1[numStages], b2[numStages], a1[numStages], a2[numStages];
+    Reg s1[numStages], s2[numStages];
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+    {
+        b0[stage] = Pair::splat(current[stage][0]);
+        b1[stage] = Pair::splat(current[stage][1]);
+        b2[stage] = Pair::splat(current[stage][2]);
+        a1[stage] = Pair::splat(current[stage][3]);
+        a2[stage] = Pair::splat(current[stage][4]);
+        s1[stage] = Pair::loadState(state.data() + stage * 4);
+        s2[stage] = Pair::loadState(state.data() + stage * 4 + 2);
+    }
+
+    for(int i = 0; i < numSamples; ++i)
+    {
+        Reg x = Pair::load(static_cast<StateType>(left[i]), numChannels > 1 ? static_cast<StateType>(right[i]) : StateType());
+
+        for(size_t stage = 0; stage < numStages; ++stage)
+        {
+            const Reg y = Pair::add(Pair::mul(b0[stage], x), s1[stage]);
+            s1[stage] = Pair::add(Pair::sub(Pair::mul(b1[stage], x), Pair::mul(a1[stage], y)), s2[stage]);
+            s2[stage] = Pair::sub(Pair::mul(b2[stage], x), Pair::mul(a2[stage], y));
+            x = y;
+        }
+
+        left[i] = static_cast<SampleType>(Pair::left(x));
+
+        if constexpr(numChannels > 1)
+            right[i] = static_cast<SampleType>(Pair::right(x));
+    }
+
+    for(size_t stage = 0; stage < numStages; ++stage)
+    {
+        Pair::storeState(state.data() + stage * 4, s1[stage]);
+        Pair::storeState(state.data() + stage * 4 + 2, s2[stage]);
+    }
+}
+
+template class TiltEQ<float>;
+template class TiltEQ<double>;
+template void TiltEQ<float>::process<1>(float*, float*, int) noexcept;
+template void TiltEQ<float>::process<2>(float*, float*, int) noexcept;
+template void TiltEQ<float>::process<1>(double*, double*, int) noexcept;
+template void TiltEQ<float>::process<2>(double*, double*, int) noexcept;
+template void TiltEQ<double>::process<1>(float*, float*, int) noexcept;
+template void TiltEQ<double>::process<2>(float*, float*, int) noexcept;
+template void TiltEQ<double>::process<1>(double*, double*, int) noexcept;
+template void TiltEQ<double>::process<2>(double*, double*, int) noexcept;
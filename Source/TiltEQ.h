@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    TiltEQ.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+
+// The DARK / LIGHT tilt on the wet path: a two stage biquad cascade that
+// filters both channels at once in one SIMD register. Coefficients are only
+// recomputed when the tilt or the sample rate changes, and are then ramped
+// linearly every controlInterval samples. A straight line between two stable
+// biquads stays stable (the stable a1 / a2 region is convex), so the ramp
+// can't blow up.
+template <typename StateType>
+class TiltEQ
+{
+public:
+    static constexpr int numStages = 2;
+    static constexpr int controlInterval = 32;
+
+    void prepare(double newSampleRate);
+    void reset();
+
+    // darkLight is the DARK_LIGHT value. Without smoothing the new
+    // coefficients apply straight away.
+    void setTilt(float darkLight, bool smooth = true) noexcept;
+
+    // Filters float or double audio in place. numChannels is 1 or 2; a mono
+    // block ignores right, which may be nullptr.
+    template <int numChannels, typename SampleType>
+    void process(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    // Takes over the other precision's filter state and ramp position. The
+    // target coefficients are recomputed in this precision.
+    template <typename OtherType>
+    void copyStateFrom(const TiltEQ<OtherType>& other) noexcept
+    {
+        tilt = other.tilt;
+        updateTarget();
+
+        stepsLeft = other.stepsLeft;
+        samplesUntilUpdate = other.samplesUntilUpdate;
+
+        for(size_t stage = 0; stage < numStages; ++stage)
+        {
+            for(size_t i = 0; i < 5; ++i)
+            {
+                current[stage][i] = stepsLeft > 0 ? static_cast<StateType>(other.current[stage][i])
+                                                  : target[stage][i];
+                increment[stage][i] = stepsLeft > 0 ? (target[stage][i] - current[stage][i]) / static_cast<StateType>(stepsLeft)
+                                                    : StateType();
+            }
+        }
+
+        for(size_t i = 0; i < state.size(); ++i)
+            state[i] = static_cast<StateType>(other.state[i]);
+    }
+
+private:
+    template <typename> friend class TiltEQ;
+
+    // b0, b1, b2, a1, a2 normalised by a0, as in juce::dsp::IIR::Coefficients.
+    using Coefficients = std::array<StateType, 5>;
+
+    void updateTarget() noexcept;
+    void advanceRamp() noexcept;
+    template <int numChannels, typename SampleType>
+    void processRun(SampleType* left, SampleType* right, int numSamples) noexcept;
+
+    double sampleRate = 44100.0;
+    float tilt = 0.0f;
+    int rampSteps = 1;
+    int stepsLeft = 0;
+    int samplesUntilUpdate = 0;
+
+    std::array<Coefficients, numStages> current {}, target {}, increment {};
+
+    // Transposed direct form II state, laid out as {s1 L, s1 R, s2 L, s2 R}
+    // per stage.
+    std::array<StateType, numStages * 4> state {};
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    WetStages.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "JuceHeader.h"
+#include "StagePipeline.h"
+#include "PrecisionFilters.h"
+
+template <typename SampleType>
+using LinearDelayLine = juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::Linear>;
+
+// Per-frame stages for the wet path. They hold references to DSP objects
+// owned elsewhere, so all the state stays in the processor's DSPState.
+namespace WetStages
+{
+    template <typename SampleType>
+    struct PreDelay
+    {
+        LinearDelayLine<SampleType>& delayL;
+        LinearDelayLine<SampleType>& delayR;
+
+        template <int numChannels>
+        StereoFrame<SampleType> processFrame(StereoFrame<SampleType> frame, int) noexcept
+        {
+            delayL.pushSample(0, frame.left);
+            frame.left = delayL.popSample(0);
+
+            if constexpr(numChannels > 1)
+            {
+                delayR.pushSample(0, frame.right);
+                frame.right = delayR.popSample(0);
+            }
+
+            return frame;
+        }
+    };
+
+    template <typename StateType>
+    struct StaticFilter
+    {
+        TptFilter<StateType>& filterL;
+        TptFilter<StateType>& filterR;
+
+        template <int numChannels, typename SampleType>
+        StereoFrame<SampleType> processFrame(StereoFrame<SampleType> frame, int) noexcept
+        {
+            frame.left = filterL.processSample(frame.left);
+            if constexpr(numChannels > 1)
+                frame.right = filterR.processSample(frame.right);
+
+            return frame;
+        }
+    };
+
+    // Peak follower, leaves the signal untouched. In mono the right envelope
+    // mirrors the left.
+    struct EnvelopeFollower
+    {
+        float& envelopeL;
+        float& envelopeR;
+        float releaseRate;
+
+        template <int numChannels, typename SampleType>
+        StereoFrame<SampleType> processFrame(StereoFrame<SampleType> frame, int) noexcept
+        {
+            envelopeL = std::max(static_cast<float>(std::abs(frame.left)), envelopeL * releaseRate);
+
+            if constexpr(numChannels > 1)
+                envelopeR = std::max(static_cast<float>(std::abs(frame.right)), envelopeR * releaseRate);
+            else
+                envelopeR = envelopeL;
+
+            return frame;
+        }
+    };
+
+    template <typename SampleType>
+    struct DryWetMix
+    {
+        const SampleType* dryL;
+        const SampleType* dryR;
+        const float* wetAmount;
+
+        template <int numChannels>
+        StereoFrame<SampleType> processFrame(StereoFrame<SampleType> frame, int index) noexcept
+        {
+            const float wet = wetAmount[index];
+
+            frame.left = dryL[index] * (1.0f - wet) + frame.left * wet;
+            if constexpr(numChannels > 1)
+                frame.right = dryR[index] * (1.0f - wet) + frame.right * wet;
+
+            return frame;
+        }
+    };
+}
@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 17 Oct 2026
+
+    Runs verbMASCHINEAudioProcessor without a host or editor across a matrix
+    of sample rates, block sizes, parameter settings and processing
+    precisions and prints the cost of each run as JSON. Built with
+    VERBMASCHINE_STAGE_TIMING on, each run also lists what every stage of
+    processBlock cost.
+
+      verbMASCHINE_Benchmark [--seconds 2] [--quick] [--precision float|double|both]
+                             [--output results.json]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ToolHelpers.h"
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    struct Setting
+    {
+        const char* name;
+        float gain, verb, darkLight, bypass;
+        int reverbEngine;
+    };
+
+    // Parameter values are in their plain ranges, as shown on the knobs.
+    const Setting allSettings[] =
+    {
+        {"default",   0.25f, 0.25f, 0.0f,  0.0f, ReverbEngine::freeverb},
+        {"clean",     0.0f,  0.25f, 0.0f,  0.0f, ReverbEngine::freeverb},
+        {"fuzz",      1.0f,  0.25f, 0.0f,  0.0f, ReverbEngine::freeverb},
+        {"fullyWet",  0.25f, 1.0f,  0.0f,  0.0f, ReverbEngine::freeverb},
+        {"dark",      0.25f, 0.25f, -1.0f, 0.0f, ReverbEngine::freeverb},
+        {"light",     0.25f, 0.25f, 1.0f,  0.0f, ReverbEngine::freeverb},
+        {"bypassed",  0.25f, 0.25f, 0.0f,  1.0f, ReverbEngine::freeverb},
+        {"fdn8",      0.25f, 0.25f, 0.0f,  0.0f, ReverbEngine::fdn8},
+        {"fdn16",     0.25f, 0.25f, 0.0f,  0.0f, ReverbEngine::fdn16}
+    };
+
+    const double allSampleRates[] = {44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0};
+    const int allBlockSizes[] = {1, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+    // Noise bursts with gaps, so the gate, envelope followers and the tail
+    // all see both signal and decay.
+    juce::AudioBuffer<float> makeInput(double sampleRate, int numSamples)
+    {
+        juce::AudioBuffer<float> input(2, numSamples);
+        juce::Random random(0x5eed);
+
+        const int burstLength = juce::roundToInt(sampleRate * 0.25);
+
+        for(int i = 0; i < numSamples; ++i)
+        {
+            const bool inBurst = (i / burstLength) % 2 == 0;
+            input.setSample(0, i, inBurst ? (random.nextFloat() * 2.0f - 1.0f) * 0.5f : 0.0f);
+            input.setSample(1, i, inBurst ? (random.nextFloat() * 2.0f - 1.0f) * 0.5f : 0.0f);
+        }
+
+        return input;
+    }
+
+    double percentile(const std::vector<double>& sorted, double fraction)
+    {
+        if(sorted.empty())
+            return 0.0;
+
+        const auto index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[juce::jlimit<size_t>(0, sorted.size() - 1, index == 0 ? 0 : index - 1)];
+    }
+
+    template <typename SampleType>
+    juce::var runOne(double sampleRate, int blockSize, const Setting& setting, double seconds)
+    {
+        constexpr bool doublePrecision = std::is_same_v<SampleType, double>;
+        auto processor = std::make_unique<verbMASCHINEAudioProcessor>();
+        processor->setProcessingPrecision(doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                          : juce::AudioProcessor::singlePrecision);
+
+        ToolHelpers::setParameter(*processor, "GAIN", setting.gain);
+        ToolHelpers::setParameter(*processor, "VERB", setting.verb);
+        ToolHelpers::setParameter(*processor, "DARK_LIGHT", setting.darkLight);
+        ToolHelpers::setParameter(*processor, "BYPASS", setting.bypass);
+        ToolHelpers::setParameter(*processor, "REVERB_ENGINE", static_cast<float>(setting.reverbEngine));
+
+        ToolHelpers::prepare(*processor, sampleRate, blockSize);
+
+        const int numBlocks = juce::jmax(1, juce::roundToInt(sampleRate * seconds) / blockSize);
+        juce::AudioBuffer<SampleType> input;
+        input.makeCopyOf(makeInput(sampleRate, numBlocks * blockSize));
+
+        juce::AudioBuffer<SampleType> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+
+        // Warm up caches and let the parameter smoothing settle.
+        const int warmUpBlocks = juce::jmin(numBlocks, juce::jmax(8, juce::roundToInt(sampleRate * 0.1) / blockSize));
+        for(int block = 0; block < warmUpBlocks; ++block)
+        {
+            for(int channel = 0; channel < 2; ++channel)
+                buffer.copyFrom(channel, 0, input, channel, block * blockSize, blockSize);
+
+            processor->processBlock(buffer, midi);
+        }
+
+       #if VERBMASCHINE_STAGE_TIMING
+        processor->stageProfiler.reset();
+       #endif
+
+        std::vector<double> blockTimes;
+        blockTimes.reserve((size_t) numBlocks);
+        double totalNs = 0.0;
+
+        for(int block = 0; block < numBlocks; ++block)
+        {
+            for(int channel = 0; channel < 2; ++channel)
+                buffer.copyFrom(channel, 0, input, channel, block * blockSize, blockSize);
+
+            const auto start = std::chrono::steady_clock::now();
+            processor->processBlock(buffer, midi);
+            const auto end = std::chrono::steady_clock::now();
+
+            const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            blockTimes.push_back(ns);
+            totalNs += ns;
+        }
+
+        const auto footprint = processor->estimateMemoryFootprint();
+        processor->releaseResources();
+
+        std::sort(blockTimes.begin(), blockTimes.end());
+
+        const double numSamples = static_cast<double>(numBlocks) * blockSize;
+        const double blockDurationNs = 1.0e9 * blockSize / sampleRate;
+
+        auto* result = new juce::DynamicObject();
+        result->setProperty("sampleRate", sampleRate);
+        result->setProperty("blockSize", blockSize);
+        result->setProperty("setting", setting.name);
+        result->setProperty("precision", doublePrecision ? "double" : "float");
+
+        auto* parameters = new juce::DynamicObject();
+        parameters->setProperty("GAIN", setting.gain);
+        parameters->setProperty("VERB", setting.verb);
+        parameters->setProperty("DARK_LIGHT", setting.darkLight);
+        parameters->setProperty("BYPASS", setting.bypass);
+        parameters->setProperty("REVERB_ENGINE", ReverbEngine::getEngineNames()[setting.reverbEngine]);
+        result->setProperty("parameters", juce::var(parameters));
+
+        result->setProperty("numBlocks", numBlocks);
+        result->setProperty("nsPerSample", totalNs / numSamples);
+        result->setProperty("realtimeFactor", totalNs > 0.0 ? (numSamples / sampleRate) * 1.0e9 / totalNs : 0.0);
+
+        auto* blockTime = new juce::DynamicObject();
+        blockTime->setProperty("meanNs", totalNs / numBlocks);
+        blockTime->setProperty("p50Ns", percentile(blockTimes, 0.5));
+        blockTime->setProperty("p99Ns", percentile(blockTimes, 0.99));
+        blockTime->setProperty("p999Ns", percentile(blockTimes, 0.999));
+        blockTime->setProperty("maxNs", blockTimes.back());
+        blockTime->setProperty("budgetNs", blockDurationNs);
+        result->setProperty("blockTime", juce::var(blockTime));
+
+        auto* memory = new juce::DynamicObject();
+        memory->setProperty("processor", (juce::int64) footprint.processor);
+        memory->setProperty("delayLines", (juce::int64) footprint.delayLines);
+        memory->setProperty("reverb", (juce::int64) footprint.reverb);
+        memory->setProperty("fuzz", (juce::int64) footprint.fuzz);
+        memory->setProperty("blockBuffers", (juce::int64) footprint.blockBuffers);
+        memory->setProperty("analyzer", (juce::int64) footprint.analyzer);
+        result->setProperty("approxBytesPerInstance", (juce::int64) footprint.getTotal());
+        result->setProperty("approxMemory", juce::var(memory));
+
+       #if VERBMASCHINE_STAGE_TIMING
+        result->setProperty("stages", processor->stageProfiler.toJson());
+       #endif
+
+        return juce::var(result);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const bool quick = args.containsOption("--quick");
+    const double seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue()
+                                                            : (quick ? 0.5 : 2.0);
+
+    std::vector<double> sampleRates(std::begin(allSampleRates), std::end(allSampleRates));
+    std::vector<int> blockSizes(std::begin(allBlockSizes), std::end(allBlockSizes));
+    std::vector<Setting> settings(std::begin(allSettings), std::end(allSettings));
+
+    const auto precision = args.containsOption("--precision") ? args.getValueForOption("--precision") : juce::String("both");
+    const bool runFloat = precision != "double";
+    const bool runDouble = precision != "float";
+
+    if(quick)
+    {
+        sampleRates = {48000.0};
+        blockSizes = {64, 512};
+        settings.resize(2);
+    }
+
+    juce::Array<juce::var> results;
+
+    for(auto sampleRate : sampleRates)
+    {
+        for(auto blockSize : blockSizes)
+        {
+            for(auto& setting : settings)
+            {
+                std::cerr << "Running " << sampleRate << " Hz, " << blockSize << " samples, "
+                          << setting.name << std::endl;
+
+                if(runFloat)
+                    results.add(runOne<float>(sampleRate, blockSize, setting, seconds));
+
+                if(runDouble)
+                    results.add(runOne<double>(sampleRate, blockSize, setting, seconds));
+            }
+        }
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("plugin", "verbMASCHINE");
+    root->setProperty("secondsPerRun", seconds);
+    root->setProperty("results", results);
+
+    const auto json = juce::JSON::toString(juce::var(root));
+
+    if(args.containsOption("--output"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+
+        if(! file.replaceWithText(json))
+        {
+            std::cerr << "Couldn't write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    std::cout << json << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    FastMathTest.cpp
+    Created: 17 Oct 2026
+
+    Checks the FastMath approximations against the std versions over their
+    working ranges, and times both.
+
+      verbMASCHINE_FastMathTest            accuracy only, exit code 1 on failure
+      verbMASCHINE_FastMathTest --bench    accuracy, then microbenchmarks
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FastMath.h"
+#include <cfloat>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+namespace
+{
+    constexpr int numTestPoints = 1 << 20;
+
+    enum class Spacing {linear, logarithmic};
+
+    // scaled is the absolute error over max(1, |expected|), for results
+    // that can be large but should be accurate near 0 too. A relative error
+    // counts a result flushed to 0 below FLT_MIN as exact.
+    enum class Error {absolute, relative, scaled};
+
+    struct AccuracyCase
+    {
+        const char* name;
+        float low, high;
+        Spacing spacing;
+        Error measure;
+        double bound;
+        std::function<double(float)> reference;
+        std::function<float(float)> approximation;
+    };
+
+    float getTestPoint(const AccuracyCase& testCase, int i)
+    {
+        const double position = static_cast<double>(i) / numTestPoints;
+
+        if(testCase.spacing == Spacing::linear)
+            return testCase.low + (testCase.high - testCase.low) * static_cast<float>(position);
+
+        const double logLow = std::log((double) testCase.low);
+        const double logHigh = std::log((double) testCase.high);
+        return juce::jlimit(testCase.low, testCase.high, static_cast<float>(std::exp(logLow + (logHigh - logLow) * position)));
+    }
+
+    bool runAccuracy(const AccuracyCase& testCase)
+    {
+        double worstError = 0.0;
+        float worstInput = testCase.low;
+
+        for(int i = 0; i <= numTestPoints; ++i)
+        {
+            const float x = getTestPoint(testCase, i);
+            const double expected = testCase.reference(x);
+            const double actual = testCase.approximation(x);
+
+            double error = std::abs(actual - expected);
+
+            if(testCase.measure == Error::scaled)
+                error /= juce::jmax(1.0, std::abs(expected));
+            else if(testCase.measure == Error::relative && std::abs(expected) < FLT_MIN && actual == 0.0)
+                error = 0.0;
+            else if(testCase.measure == Error::relative && expected != 0.0)
+                error /= std::abs(expected);
+
+            if(error > worstError)
+            {
+                worstError = error;
+                worstInput = x;
+            }
+        }
+
+        const bool passed = worstError <= testCase.bound;
+
+        std::cout << (passed ? "PASS " : "FAIL ") << testCase.name
+                  << (testCase.measure == Error::relative ? "  max rel error "
+                      : testCase.measure == Error::scaled ? "  max scaled error " : "  max abs error ") << worstError
+                  << " at " << worstInput << " (bound " << testCase.bound << ")" << std::endl;
+
+        return passed;
+    }
+
+    // Time per call over a buffer, so the compiler can vectorise where it is able to.
+    template <typename Function>
+    double nsPerCall(const std::vector<float>& input, std::vector<float>& output, Function&& function)
+    {
+        constexpr int repeats = 50;
+        const auto start = std::chrono::steady_clock::now();
+
+        for(int r = 0; r < repeats; ++r)
+        {
+            for(size_t i = 0; i < input.size(); ++i)
+                output[i] = function(input[i]);
+
+            juce::ignoreUnused(output[(size_t) r % output.size()]);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / (repeats * (double) input.size());
+    }
+
+    void runBenchmarks()
+    {
+        constexpr size_t size = 4096;
+        std::vector<float> input(size), output(size);
+        juce::Random random(42);
+
+        auto fill = [&](float low, float high)
+        {
+            for(auto& x : input)
+                x = low + random.nextFloat() * (high - low);
+        };
+
+        volatile float sink = 0.0f;
+
+        auto report = [&](const char* name, double stdNs, double fastNs)
+        {
+            sink = sink + output[0];
+            std::cout << name << "  std " << stdNs << " ns  fast " << fastNs << " ns  speedup "
+                      << (fastNs > 0.0 ? stdNs / fastNs : 0.0) << "x" << std::endl;
+        };
+
+        fill(0.0f, 1.0f);
+        report("pow(x, 2.2)",
+               nsPerCall(input, output, [](float x) { return std::pow(x, 2.2f); }),
+               nsPerCall(input, output, [](float x) { return FastMath::pow(x, 2.2f); }));
+
+        fill(1.0e-5f, 2.0f);
+        report("gainToDecibels",
+               nsPerCall(input, output, [](float x) { return juce::Decibels::gainToDecibels(x); }),
+               nsPerCall(input, output, [](float x) { return FastMath::gainToDecibels(x); }));
+
+        fill(-2.0f, 2.0f);
+        report("tanh",
+               nsPerCall(input, output, [](float x) { return std::tanh(x); }),
+               nsPerCall(input, output, [](float x) { return FastMath::tanh(x); }));
+
+        fill(0.0f, 1.0f);
+        report("pow(x, 2.0)",
+               nsPerCall(input, output, [](float x) { return std::pow(x, 2.0f); }),
+               nsPerCall(input, output, [](float x) { return x * x; }));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    // The log spaced cases run down to FLT_MIN, where the fixed step ones
+    // never get.
+    const AccuracyCase cases[] =
+    {
+        {"log2", FLT_MIN, FLT_MAX, Spacing::logarithmic, Error::scaled, 2.0e-7,
+         [](float x) { return std::log2((double) x); },
+         [](float x) { return FastMath::log2(x); }},
+        {"exp2", -125.9f, 125.9f, Spacing::linear, Error::relative, 3.0e-7,
+         [](float x) { return std::exp2((double) x); },
+         [](float x) { return FastMath::exp2(x); }},
+        {"pow(x, 2.2)", 0.0f, 1.0f, Spacing::linear, Error::relative, 4.0e-6,
+         [](float x) { return std::pow((double) x, 2.2); },
+         [](float x) { return FastMath::pow(x, 2.2f); }},
+        {"pow(x, 2.5)", 0.0f, 1.0f, Spacing::linear, Error::relative, 4.0e-6,
+         [](float x) { return std::pow((double) x, 2.5); },
+         [](float x) { return FastMath::pow(x, 2.5f); }},
+        {"pow(x, 2) above 1e-12", 1.0e-6f, 1.0f, Spacing::logarithmic, Error::relative, 4.0e-6,
+         [](float x) { return std::pow((double) x, 2.0); },
+         [](float x) { return FastMath::pow(x, 2.0f); }},
+        {"pow(x, 3) above 1e-12", 1.0e-4f, 1.0f, Spacing::logarithmic, Error::relative, 4.0e-6,
+         [](float x) { return std::pow((double) x, 3.0); },
+         [](float x) { return FastMath::pow(x, 3.0f); }},
+        {"pow(x, 2.2) to FLT_MIN", FLT_MIN, 1.0f, Spacing::logarithmic, Error::relative, 1.0e-5,
+         [](float x) { return std::pow((double) x, 2.2); },
+         [](float x) { return FastMath::pow(x, 2.2f); }},
+        {"pow(x, 3) to FLT_MIN", FLT_MIN, 1.0f, Spacing::logarithmic, Error::relative, 1.0e-5,
+         [](float x) { return std::pow((double) x, 3.0); },
+         [](float x) { return FastMath::pow(x, 3.0f); }},
+        {"gainToDecibels", FLT_MIN, 4.0f, Spacing::logarithmic, Error::absolute, 1.2e-5,
+         [](float x) { return juce::jmax(-100.0, 20.0 * std::log10((double) x)); },
+         [](float x) { return FastMath::gainToDecibels(x); }},
+        {"tanh", -12.0f, 12.0f, Spacing::linear, Error::absolute, 3.0e-7,
+         [](float x) { return std::tanh((double) x); },
+         [](float x) { return FastMath::tanh(x); }}
+    };
+
+    bool allPassed = true;
+
+    for(auto& testCase : cases)
+        allPassed = runAccuracy(testCase) && allPassed;
+
+    if(args.containsOption("--bench"))
+        runBenchmarks();
+
+    return allPassed ? 0 : 1;
+}
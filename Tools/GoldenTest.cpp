@@ -0,0 +1,547 @@
+/*
+  ==============================================================================
+
+    GoldenTest.cpp
+    Created: 17 Oct 2026
+
+    Renders fixed test signals through the processor at several parameter
+    states and sample rates and checks them against stored reference renders.
+
+      verbMASCHINE_GoldenTest --record <dir>
+      verbMASCHINE_GoldenTest --compare <dir> [--report <dir>]
+                              [--sample-tolerance 1e-4] [--spectral-tolerance 0.5]
+      verbMASCHINE_GoldenTest --block-sizes
+
+    --compare exits with 0 when every case is within tolerance and 1 when any
+    case fails or no references have been recorded. Failing cases get the
+    actual render and the difference written to the report folder, next to a
+    report.json with the metrics of every case.
+
+    --block-sizes needs no references. It renders every case again at other
+    host block sizes and fails unless each render is identical to the one at
+    the default size. It does the same for a wake-up case: the reverb tail
+    dies away until the processor sleeps, then a transient wakes it partway
+    through a control step.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ToolHelpers.h"
+#include <iostream>
+
+namespace
+{
+    constexpr int blockSize = 512;
+    const int otherBlockSizes[] = {13, 100, 4096};
+    constexpr double renderSeconds = 3.0;
+    const int wakeUpBlockSizes[] = {1, 13, 4096};
+    constexpr double wakeUpSeconds = 17.0;
+
+    // === Test Signals === //
+    int lengthFor(double sampleRate) {return juce::roundToInt(sampleRate * renderSeconds);}
+
+    juce::AudioBuffer<float> makeImpulse(double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, lengthFor(sampleRate));
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0f);
+        buffer.setSample(1, 0, 1.0f);
+        return buffer;
+    }
+
+    // Exponential sweeps over the first two seconds, up on the left and down
+    // on the right, followed by silence.
+    juce::AudioBuffer<float> makeSweep(double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, lengthFor(sampleRate));
+        buffer.clear();
+
+        const int sweepLength = juce::roundToInt(sampleRate * 2.0);
+        const double lowHz = 20.0;
+        const double highHz = juce::jmin(20000.0, sampleRate * 0.45);
+        const double k = std::log(highHz / lowHz);
+
+        for(int channel = 0; channel < 2; ++channel)
+        {
+            double phase = 0.0;
+
+            for(int i = 0; i < sweepLength; ++i)
+            {
+                double position = static_cast<double>(i) / sweepLength;
+                if(channel == 1)
+                    position = 1.0 - position;
+
+                phase += juce::MathConstants<double>::twoPi * lowHz * std::exp(k * position) / sampleRate;
+                buffer.setSample(channel, i, static_cast<float>(0.5 * std::sin(phase)));
+            }
+        }
+
+        return buffer;
+    }
+
+    // 50 ms of independent noise per channel every 400 ms for 1.6 s.
+    juce::AudioBuffer<float> makeNoiseBursts(double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, lengthFor(sampleRate));
+        buffer.clear();
+
+        juce::Random random(1234);
+        const int burstLength = juce::roundToInt(sampleRate * 0.05);
+        const int burstSpacing = juce::roundToInt(sampleRate * 0.4);
+
+        for(int burstStart = 0; burstStart < juce::roundToInt(sampleRate * 1.6); burstStart += burstSpacing)
+        {
+            for(int channel = 0; channel < 2; ++channel)
+            {
+                for(int i = burstStart; i < burstStart + burstLength; ++i)
+                    buffer.setSample(channel, i, (random.nextFloat() * 2.0f - 1.0f) * 0.7f);
+            }
+        }
+
+        return buffer;
+    }
+
+    // A short, loud 1 kHz burst and then nothing: checks how the tail decays.
+    juce::AudioBuffer<float> makeTransientThenSilence(double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, lengthFor(sampleRate));
+        buffer.clear();
+
+        const int burstLength = juce::roundToInt(sampleRate * 0.02);
+
+        for(int i = 0; i < burstLength; ++i)
+        {
+            const auto value = static_cast<float>(0.9 * std::sin(juce::MathConstants<double>::twoPi * 1000.0 * i / sampleRate));
+            buffer.setSample(0, i, value);
+            buffer.setSample(1, i, value);
+        }
+
+        return buffer;
+    }
+
+    // Well after the tail of the first burst has died away and the processor
+    // has gone to sleep, half a control step plus one sample past the grid.
+    int getWakeUpStart(double sampleRate)
+    {
+        constexpr int grid = verbMASCHINEAudioProcessor::controlBlockSize;
+        return juce::roundToInt(sampleRate * 15.0) / grid * grid + grid / 2 + 1;
+    }
+
+    // The transient of makeTransientThenSilence, then again at getWakeUpStart().
+    juce::AudioBuffer<float> makeWakeUp(double sampleRate)
+    {
+        juce::AudioBuffer<float> buffer(2, juce::roundToInt(sampleRate * wakeUpSeconds));
+        buffer.clear();
+
+        const auto transient = makeTransientThenSilence(sampleRate);
+        const int burstLength = juce::roundToInt(sampleRate * 0.02);
+
+        for(int channel = 0; channel < 2; ++channel)
+        {
+            buffer.copyFrom(channel, 0, transient, channel, 0, burstLength);
+            buffer.copyFrom(channel, getWakeUpStart(sampleRate), transient, channel, 0, burstLength);
+        }
+
+        return buffer;
+    }
+
+    struct Signal
+    {
+        const char* name;
+        juce::AudioBuffer<float> (*make)(double);
+    };
+
+    const Signal signals[] =
+    {
+        {"impulse", makeImpulse},
+        {"sweep", makeSweep},
+        {"noiseBursts", makeNoiseBursts},
+        {"transientThenSilence", makeTransientThenSilence}
+    };
+
+    // === Parameter States === //
+    // Anything not listed stays at its default.
+    struct State
+    {
+        const char* name;
+        std::vector<std::pair<const char*, float>> parameters;
+    };
+
+    const std::vector<State> states =
+    {
+        {"default", {}},
+        {"clean", {{"GAIN", 0.0f}}},
+        {"fuzz", {{"GAIN", 1.0f}, {"VERB", 0.5f}}},
+        {"fuzz4x", {{"GAIN", 1.0f}, {"FUZZ_QUALITY", 2.0f}}},
+        {"wetDark", {{"VERB", 1.0f}, {"DARK_LIGHT", -1.0f}}},
+        {"wetLight", {{"VERB", 1.0f}, {"DARK_LIGHT", 1.0f}, {"VOL", -12.0f}}},
+        {"bypassed", {{"BYPASS", 1.0f}}}
+    };
+
+    const double sampleRates[] = {44100.0, 96000.0};
+
+    struct Case
+    {
+        const Signal& signal;
+        const State& state;
+        double sampleRate;
+
+        juce::String getName() const
+        {
+            return juce::String(signal.name) + "_" + state.name + "_" + juce::String(juce::roundToInt(sampleRate));
+        }
+    };
+
+    std::vector<Case> getCases()
+    {
+        std::vector<Case> cases;
+
+        for(auto sampleRate : sampleRates)
+            for(auto& state : states)
+                for(auto& signal : signals)
+                    cases.push_back({signal, state, sampleRate});
+
+        return cases;
+    }
+
+    juce::AudioBuffer<float> renderCase(const Case& testCase, int caseBlockSize = blockSize)
+    {
+        verbMASCHINEAudioProcessor processor;
+
+        for(auto& [id, value] : testCase.state.parameters)
+            ToolHelpers::setParameter(processor, id, value);
+
+        ToolHelpers::prepare(processor, testCase.sampleRate, caseBlockSize);
+        return ToolHelpers::render(processor, testCase.signal.make(testCase.sampleRate), caseBlockSize);
+    }
+
+    struct WakeUpRender
+    {
+        juce::AudioBuffer<float> output;
+        bool asleepBeforeTransient = false;
+    };
+
+    // Full reverb, so there is a long tail to wait out before sleeping.
+    WakeUpRender renderWakeUp(double sampleRate, int caseBlockSize)
+    {
+        verbMASCHINEAudioProcessor processor;
+        ToolHelpers::setParameter(processor, "VERB", 1.0f);
+        ToolHelpers::prepare(processor, sampleRate, caseBlockSize);
+
+        WakeUpRender result;
+        result.output = makeWakeUp(sampleRate);
+
+        const int wakeUpStart = getWakeUpStart(sampleRate);
+        juce::MidiBuffer midi;
+
+        for(int start = 0; start < result.output.getNumSamples(); start += caseBlockSize)
+        {
+            const int numSamples = juce::jmin(caseBlockSize, result.output.getNumSamples() - start);
+            juce::AudioBuffer<float> block(result.output.getArrayOfWritePointers(), result.output.getNumChannels(),
+                                           start, numSamples);
+            processor.processBlock(block, midi);
+
+            if(start + numSamples <= wakeUpStart)
+                result.asleepBeforeTransient = processor.isSleeping();
+        }
+
+        return result;
+    }
+
+    // === Comparison === //
+    struct Comparison
+    {
+        bool lengthsMatch = true;
+        double maxSampleError = 0.0;
+        int worstSample = 0;
+        double errorRmsDb = -200.0;
+        double maxSpectralDifferenceDb = 0.0;
+    };
+
+    // Largest mean per bin level difference over all analysis frames, in dB.
+    // Bins below floorDb in both signals are ignored, so the comparison is not
+    // dominated by noise far below anything audible.
+    double spectralDifference(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& actual)
+    {
+        constexpr int fftOrder = 11;
+        constexpr int fftSize = 1 << fftOrder;
+        constexpr int hopSize = fftSize / 2;
+        constexpr float floorDb = -100.0f;
+
+        juce::dsp::FFT fft(fftOrder);
+        juce::dsp::WindowingFunction<float> window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+        std::vector<float> referenceFrame((size_t) fftSize * 2), actualFrame((size_t) fftSize * 2);
+        const float normalisation = 2.0f / fftSize;
+        double worst = 0.0;
+
+        for(int channel = 0; channel < reference.getNumChannels(); ++channel)
+        {
+            for(int start = 0; start + fftSize <= reference.getNumSamples(); start += hopSize)
+            {
+                std::fill(referenceFrame.begin(), referenceFrame.end(), 0.0f);
+                std::fill(actualFrame.begin(), actualFrame.end(), 0.0f);
+                std::copy_n(reference.getReadPointer(channel, start), fftSize, referenceFrame.begin());
+                std::copy_n(actual.getReadPointer(channel, start), fftSize, actualFrame.begin());
+
+                window.multiplyWithWindowingTable(referenceFrame.data(), (size_t) fftSize);
+                window.multiplyWithWindowingTable(actualFrame.data(), (size_t) fftSize);
+                fft.performFrequencyOnlyForwardTransform(referenceFrame.data(), true);
+                fft.performFrequencyOnlyForwardTransform(actualFrame.data(), true);
+
+                double sum = 0.0;
+                int numBins = 0;
+
+                for(int bin = 0; bin <= fftSize / 2; ++bin)
+                {
+                    const auto referenceDb = juce::Decibels::gainToDecibels(referenceFrame[(size_t) bin] * normalisation, floorDb);
+                    const auto actualDb = juce::Decibels::gainToDecibels(actualFrame[(size_t) bin] * normalisation, floorDb);
+
+                    if(referenceDb <= floorDb && actualDb <= floorDb)
+                        continue;
+
+                    sum += std::abs(referenceDb - actualDb);
+                    ++numBins;
+                }
+
+                if(numBins > 0)
+                    worst = juce::jmax(worst, sum / numBins);
+            }
+        }
+
+        return worst;
+    }
+
+    Comparison compare(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& actual)
+    {
+        Comparison result;
+
+        if(reference.getNumChannels() != actual.getNumChannels()
+           || reference.getNumSamples() != actual.getNumSamples())
+        {
+            result.lengthsMatch = false;
+            return result;
+        }
+
+        double sumSquares = 0.0;
+
+        for(int channel = 0; channel < reference.getNumChannels(); ++channel)
+        {
+            auto* referenceData = reference.getReadPointer(channel);
+            auto* actualData = actual.getReadPointer(channel);
+
+            for(int i = 0; i < reference.getNumSamples(); ++i)
+            {
+                const double error = std::abs((double) actualData[i] - referenceData[i]);
+                sumSquares += error * error;
+
+                if(error > result.maxSampleError)
+                {
+                    result.maxSampleError = error;
+                    result.worstSample = i;
+                }
+            }
+        }
+
+        const double numSamples = (double) reference.getNumChannels() * reference.getNumSamples();
+        result.errorRmsDb = juce::Decibels::gainToDecibels(std::sqrt(sumSquares / numSamples), -200.0);
+        result.maxSpectralDifferenceDb = spectralDifference(reference, actual);
+
+        return result;
+    }
+
+    juce::AudioBuffer<float> difference(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& actual)
+    {
+        juce::AudioBuffer<float> diff;
+        diff.makeCopyOf(actual);
+
+        for(int channel = 0; channel < diff.getNumChannels(); ++channel)
+            diff.addFrom(channel, 0, reference, channel, 0, diff.getNumSamples(), -1.0f);
+
+        return diff;
+    }
+
+    // === Modes === //
+    int record(const juce::File& folder)
+    {
+        if(! folder.createDirectory())
+        {
+            std::cerr << "Couldn't create " << folder.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        for(auto& testCase : getCases())
+        {
+            const auto file = folder.getChildFile(testCase.getName() + ".wav");
+            std::cout << "Recording " << file.getFileName() << std::endl;
+
+            if(! ToolHelpers::writeWav(file, renderCase(testCase), testCase.sampleRate))
+            {
+                std::cerr << "Couldn't write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    int compareAll(const juce::File& folder, const juce::File& reportFolder,
+                   double sampleTolerance, double spectralTolerance)
+    {
+        if(folder.findChildFiles(juce::File::findFiles, false, "*.wav").isEmpty())
+        {
+            std::cout << "No reference renders in " << folder.getFullPathName()
+                      << ", run with --record on a known good build first." << std::endl;
+            return 1;
+        }
+
+        reportFolder.createDirectory();
+
+        juce::Array<juce::var> reportCases;
+        int numFailed = 0;
+
+        for(auto& testCase : getCases())
+        {
+            const auto name = testCase.getName();
+            const auto referenceFile = folder.getChildFile(name + ".wav");
+
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("case", name);
+
+            juce::AudioBuffer<float> reference;
+            double referenceSampleRate = 0.0;
+
+            if(! ToolHelpers::readAudioFile(referenceFile, reference, referenceSampleRate))
+            {
+                std::cout << "MISSING " << name << std::endl;
+                entry->setProperty("result", "missing");
+                reportCases.add(juce::var(entry));
+                ++numFailed;
+                continue;
+            }
+
+            const auto actual = renderCase(testCase);
+            const auto comparison = compare(reference, actual);
+
+            const bool passed = comparison.lengthsMatch
+                                && comparison.maxSampleError <= sampleTolerance
+                                && comparison.maxSpectralDifferenceDb <= spectralTolerance;
+
+            entry->setProperty("result", passed ? "pass" : "fail");
+            entry->setProperty("lengthsMatch", comparison.lengthsMatch);
+            entry->setProperty("maxSampleError", comparison.maxSampleError);
+            entry->setProperty("worstSample", comparison.worstSample);
+            entry->setProperty("errorRmsDb", comparison.errorRmsDb);
+            entry->setProperty("maxSpectralDifferenceDb", comparison.maxSpectralDifferenceDb);
+            reportCases.add(juce::var(entry));
+
+            std::cout << (passed ? "PASS " : "FAIL ") << name
+                      << "  max error " << comparison.maxSampleError
+                      << " at " << comparison.worstSample
+                      << ", error rms " << comparison.errorRmsDb << " dB"
+                      << ", spectral " << comparison.maxSpectralDifferenceDb << " dB" << std::endl;
+
+            if(! passed)
+            {
+                ++numFailed;
+                ToolHelpers::writeWav(reportFolder.getChildFile(name + ".actual.wav"), actual, testCase.sampleRate);
+
+                if(comparison.lengthsMatch)
+                    ToolHelpers::writeWav(reportFolder.getChildFile(name + ".diff.wav"),
+                                          difference(reference, actual), testCase.sampleRate);
+            }
+        }
+
+        auto* report = new juce::DynamicObject();
+        report->setProperty("sampleTolerance", sampleTolerance);
+        report->setProperty("spectralToleranceDb", spectralTolerance);
+        report->setProperty("numFailed", numFailed);
+        report->setProperty("cases", reportCases);
+        reportFolder.getChildFile("report.json").replaceWithText(juce::JSON::toString(juce::var(report)));
+
+        std::cout << numFailed << " of " << reportCases.size() << " cases failed, report in "
+                  << reportFolder.getFullPathName() << std::endl;
+
+        return numFailed == 0 ? 0 : 1;
+    }
+
+    int checkBlockSizes()
+    {
+        int numFailed = 0, numChecked = 0;
+
+        for(auto& testCase : getCases())
+        {
+            const auto expected = renderCase(testCase);
+
+            for(auto size : otherBlockSizes)
+            {
+                const auto comparison = compare(expected, renderCase(testCase, size));
+                const bool passed = comparison.lengthsMatch && comparison.maxSampleError == 0.0;
+
+                std::cout << (passed ? "PASS " : "FAIL ") << testCase.getName() << " at " << size << " samples"
+                          << "  max error " << comparison.maxSampleError
+                          << " at " << comparison.worstSample << std::endl;
+
+                numFailed += passed ? 0 : 1;
+                ++numChecked;
+            }
+        }
+
+        for(auto sampleRate : sampleRates)
+        {
+            const auto expected = renderWakeUp(sampleRate, blockSize);
+
+            for(auto size : wakeUpBlockSizes)
+            {
+                const auto actual = renderWakeUp(sampleRate, size);
+                const auto comparison = compare(expected.output, actual.output);
+                const bool passed = expected.asleepBeforeTransient && actual.asleepBeforeTransient
+                                    && comparison.lengthsMatch && comparison.maxSampleError == 0.0;
+
+                std::cout << (passed ? "PASS " : "FAIL ") << "wakeUp_" << juce::roundToInt(sampleRate)
+                          << " at " << size << " samples"
+                          << (actual.asleepBeforeTransient ? "" : "  (never slept)")
+                          << "  max error " << comparison.maxSampleError
+                          << " at " << comparison.worstSample << std::endl;
+
+                numFailed += passed ? 0 : 1;
+                ++numChecked;
+            }
+        }
+
+        std::cout << numFailed << " of " << numChecked << " block size checks failed" << std::endl;
+        return numFailed == 0 ? 0 : 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    if(args.containsOption("--record"))
+        return record(cwd.getChildFile(args.getValueForOption("--record")));
+
+    if(args.containsOption("--block-sizes"))
+        return checkBlockSizes();
+
+    if(args.containsOption("--compare"))
+    {
+        const auto reportFolder = args.containsOption("--report") ? cwd.getChildFile(args.getValueForOption("--report"))
+                                                                  : cwd.getChildFile("golden-report");
+        const double sampleTolerance = args.containsOption("--sample-tolerance")
+                                           ? args.getValueForOption("--sample-tolerance").getDoubleValue() : 1.0e-4;
+        const double spectralTolerance = args.containsOption("--spectral-tolerance")
+                                             ? args.getValueForOption("--spectral-tolerance").getDoubleValue() : 0.5;
+
+        return compareAll(cwd.getChildFile(args.getValueForOption("--compare")), reportFolder,
+                          sampleTolerance, spectralTolerance);
+    }
+
+    std::cerr << "Usage: verbMASCHINE_GoldenTest --record <dir> | --compare <dir> [--report <dir>]"
+                 " [--sample-tolerance x] [--spectral-tolerance dB] | --block-sizes" << std::endl;
+    return 1;
+}
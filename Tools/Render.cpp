@@ -0,0 +1,459 @@
+/*
+  ==============================================================================
+
+    Render.cpp
+    Created: 17 Oct 2026
+
+    Runs WAV, AIFF and FLAC files through the processor offline, several
+    files at a time, and writes each one out with its reverb tail.
+
+      verbMASCHINE_Render <files or folders>... --output <dir>
+                          [--param ID=value]... [--state <file>]
+                          [--tail-threshold -90] [--max-tail 30]
+                          [--block-size 8192] [--threads <n>]
+                          [--format wav|aiff|flac]
+
+    --param values are in the parameter's plain range, as shown on the knob,
+    and are applied on top of --state, a blob saved by getStateInformation.
+    Folders are searched recursively and their layout is kept under the
+    output folder. After the input ends, silence is fed in until the output
+    has stayed below --tail-threshold dBFS for half a second, or for at most
+    --max-tail seconds, and the file is cut after the last sample above it.
+
+    Inputs are read through a memory mapped reader where the format has one
+    and streamed block by block otherwise, so file length doesn't affect
+    memory use. Each file gets its own processor. Exits with 1 if any file
+    failed.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ToolHelpers.h"
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    constexpr double tailHoldSeconds = 0.5;
+
+    struct Options
+    {
+        juce::File outputFolder;
+        juce::StringPairArray parameters;
+        juce::MemoryBlock state;
+        float tailThreshold = juce::Decibels::decibelsToGain(-90.0f);
+        double maxTailSeconds = 30.0;
+        int blockSize = 8192;
+        juce::String format = "wav";
+    };
+
+    struct Job
+    {
+        juce::File input;
+        juce::File output;
+    };
+
+    struct Result
+    {
+        bool ok = false;
+        juce::String error;
+        double audioSeconds = 0.0;
+        double tailSeconds = 0.0;
+        double wallSeconds = 0.0;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // === Reading and Writing === //
+    std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+    {
+        if(auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+        {
+            // Mapping the whole file costs address space, not memory; pages
+            // are only read in as the blocks reach them.
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+            if(mapped != nullptr && mapped->mapEntireFile())
+                return mapped;
+        }
+
+        return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+    }
+
+    std::unique_ptr<juce::AudioFormat> makeFormat(const juce::String& name)
+    {
+        if(name == "aiff") return std::make_unique<juce::AiffAudioFormat>();
+        if(name == "flac") return std::make_unique<juce::FlacAudioFormat>();
+        return std::make_unique<juce::WavAudioFormat>();
+    }
+
+    // WAV gets 32 bit float; AIFF and FLAC top out at 24 bit integer.
+    int bitsFor(const juce::String& name) {return name == "wav" ? 32 : 24;}
+
+    // Writes what comes out of the processor, minus the first latency samples
+    // so the render lines up with its input. Tail blocks hold back any quiet
+    // run until something louder follows it, so whatever is still pending
+    // when the render stops is dropped and the file ends on the last sample
+    // above the threshold.
+    class OutputWriter
+    {
+    public:
+        OutputWriter(juce::AudioFormatWriter& w, int numChannels, int latency, int maxPending)
+            : writer(w), pending(numChannels, maxPending), samplesToSkip(latency) {}
+
+        bool write(const juce::AudioBuffer<float>& block)
+        {
+            return writeOut(block, 0, block.getNumSamples());
+        }
+
+        bool writeTail(const juce::AudioBuffer<float>& block, float threshold)
+        {
+            const int numSamples = block.getNumSamples();
+            const int lastLoud = findLastAbove(block, threshold);
+
+            if(lastLoud >= 0)
+            {
+                if(! writeOut(pending, 0, pendingSamples) || ! writeOut(block, 0, lastLoud + 1))
+                    return false;
+
+                pendingSamples = 0;
+            }
+
+            const int quietStart = lastLoud + 1;
+            const int quietSamples = juce::jmin(numSamples - quietStart, pending.getNumSamples() - pendingSamples);
+
+            for(int channel = 0; channel < pending.getNumChannels(); ++channel)
+                pending.copyFrom(channel, pendingSamples, block, channel, quietStart, quietSamples);
+
+            pendingSamples += quietSamples;
+            return true;
+        }
+
+        int getPendingSamples() const noexcept        {return pendingSamples;}
+        juce::int64 getSamplesWritten() const noexcept {return samplesWritten;}
+
+    private:
+        static int findLastAbove(const juce::AudioBuffer<float>& block, float threshold)
+        {
+            int last = -1;
+
+            for(int channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                const float* data = block.getReadPointer(channel);
+
+                for(int i = block.getNumSamples() - 1; i > last; --i)
+                {
+                    if(std::abs(data[i]) > threshold)
+                    {
+                        last = i;
+                        break;
+                    }
+                }
+            }
+
+            return last;
+        }
+
+        bool writeOut(const juce::AudioBuffer<float>& buffer, int start, int numSamples)
+        {
+            const int skipped = juce::jmin(numSamples, samplesToSkip);
+            samplesToSkip -= skipped;
+            start += skipped;
+            numSamples -= skipped;
+
+            if(numSamples <= 0)
+                return true;
+
+            samplesWritten += numSamples;
+            return writer.writeFromAudioSampleBuffer(buffer, start, numSamples);
+        }
+
+        juce::AudioFormatWriter& writer;
+        juce::AudioBuffer<float> pending;
+        int pendingSamples = 0;
+        int samplesToSkip = 0;
+        juce::int64 samplesWritten = 0;
+    };
+
+    // === Rendering === //
+    Result renderFile(const Job& job, const Options& options)
+    {
+        const auto start = Clock::now();
+        Result result;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        auto reader = openReader(formatManager, job.input);
+        if(reader == nullptr)
+        {
+            result.error = "can't read the file";
+            return result;
+        }
+
+        const int numChannels = reader->numChannels == 1 ? 1 : 2;
+        const double sampleRate = reader->sampleRate;
+        const int blockSize = options.blockSize;
+
+        auto processor = std::make_unique<verbMASCHINEAudioProcessor>();
+
+        if(options.state.getSize() > 0)
+            processor->setStateInformation(options.state.getData(), (int) options.state.getSize());
+
+        for(auto& id : options.parameters.getAllKeys())
+            ToolHelpers::setParameter(*processor, id, options.parameters[id].getFloatValue());
+
+        processor->setNonRealtime(true);
+        processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        const int latency = processor->getLatencySamples();
+
+        job.output.getParentDirectory().createDirectory();
+        auto format = makeFormat(options.format);
+        auto writer = ToolHelpers::createWriter(job.output, *format, sampleRate, numChannels, bitsFor(options.format));
+        if(writer == nullptr)
+        {
+            result.error = "can't write " + job.output.getFullPathName();
+            return result;
+        }
+
+        const int holdSamples = juce::roundToInt(sampleRate * tailHoldSeconds);
+        OutputWriter output(*writer, numChannels, latency, holdSamples + blockSize);
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        const juce::int64 inputLength = reader->lengthInSamples;
+
+        for(juce::int64 position = 0; position < inputLength; position += blockSize)
+        {
+            const int numSamples = (int) juce::jmin((juce::int64) blockSize, inputLength - position);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), numChannels, 0, numSamples);
+
+            if(! reader->read(&block, 0, numSamples, position, true, true))
+            {
+                result.error = "read failed";
+                return result;
+            }
+
+            processor->processBlock(block, midi);
+
+            if(! output.write(block))
+            {
+                result.error = "write failed";
+                return result;
+            }
+        }
+
+        // The first latency samples were skipped, so the tail gets them back.
+        const juce::int64 maxTailSamples = (juce::int64) (sampleRate * options.maxTailSeconds) + latency;
+
+        for(juce::int64 flushed = 0; flushed < maxTailSamples && output.getPendingSamples() < holdSamples;
+            flushed += blockSize)
+        {
+            buffer.clear();
+            processor->processBlock(buffer, midi);
+
+            if(! output.writeTail(buffer, options.tailThreshold))
+            {
+                result.error = "write failed";
+                return result;
+            }
+        }
+
+        processor->releaseResources();
+        writer.reset();
+
+        result.ok = true;
+        result.audioSeconds = (double) output.getSamplesWritten() / sampleRate;
+        result.tailSeconds = (double) juce::jmax((juce::int64) 0, output.getSamplesWritten() - inputLength) / sampleRate;
+        result.wallSeconds = secondsSince(start);
+        return result;
+    }
+
+    // === Arguments === //
+    bool takesValue(const juce::String& option)
+    {
+        return juce::StringArray {"--output", "--param", "--state", "--tail-threshold", "--max-tail",
+                                  "--block-size", "--threads", "--format"}.contains(option);
+    }
+
+    const char* const audioWildcards = "*.wav;*.aif;*.aiff;*.flac";
+
+    juce::String extensionFor(const juce::String& format)
+    {
+        return format == "wav" ? ".wav" : (format == "aiff" ? ".aiff" : ".flac");
+    }
+
+    void addJobs(const juce::File& input, const Options& options, std::vector<Job>& jobs)
+    {
+        const auto extension = extensionFor(options.format);
+
+        if(input.isDirectory())
+        {
+            for(auto& file : input.findChildFiles(juce::File::findFiles, true, audioWildcards))
+                jobs.push_back({file, options.outputFolder.getChildFile(file.getRelativePathFrom(input))
+                                                          .withFileExtension(extension)});
+        }
+        else
+        {
+            jobs.push_back({input, options.outputFolder.getChildFile(input.getFileName()).withFileExtension(extension)});
+        }
+    }
+
+    int usage()
+    {
+        std::cerr << "Usage: verbMASCHINE_Render <files or folders>... --output <dir> [--param ID=value]..."
+                     " [--state file] [--tail-threshold dB] [--max-tail seconds] [--block-size n]"
+                     " [--threads n] [--format wav|aiff|flac]" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    Options options;
+    juce::Array<juce::File> inputs;
+    int numThreads = juce::SystemStats::getNumCpus();
+
+    for(int i = 0; i < args.size(); ++i)
+    {
+        const auto argument = args[i].text;
+
+        if(! takesValue(argument))
+        {
+            if(args[i].isOption())
+            {
+                std::cerr << "Unknown option " << argument << std::endl;
+                return usage();
+            }
+
+            inputs.add(cwd.getChildFile(argument));
+            continue;
+        }
+
+        if(i + 1 >= args.size())
+            return usage();
+
+        const auto value = args[++i].text;
+
+        if(argument == "--output")              options.outputFolder = cwd.getChildFile(value);
+        else if(argument == "--tail-threshold") options.tailThreshold = juce::Decibels::decibelsToGain(value.getFloatValue(), -1000.0f);
+        else if(argument == "--max-tail")       options.maxTailSeconds = juce::jmax(0.0, value.getDoubleValue());
+        else if(argument == "--block-size")     options.blockSize = juce::jlimit(16, 1 << 20, value.getIntValue());
+        else if(argument == "--format")         options.format = value.toLowerCase();
+        else if(argument == "--threads")        numThreads = juce::jmax(1, value.getIntValue());
+        else if(argument == "--param")
+        {
+            if(! value.containsChar('='))
+                return usage();
+
+            options.parameters.set(value.upToFirstOccurrenceOf("=", false, false),
+                                   value.fromFirstOccurrenceOf("=", false, false));
+        }
+        else if(argument == "--state")
+        {
+            const auto file = cwd.getChildFile(value);
+
+            if(! file.loadFileAsData(options.state))
+            {
+                std::cerr << "Couldn't read " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if(inputs.isEmpty() || options.outputFolder == juce::File()
+       || ! juce::StringArray {"wav", "aiff", "flac"}.contains(options.format))
+        return usage();
+
+    {
+        verbMASCHINEAudioProcessor probe;
+
+        for(auto& id : options.parameters.getAllKeys())
+        {
+            if(probe.apvts.getParameter(id) == nullptr)
+            {
+                std::cerr << "Unknown parameter " << id << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::vector<Job> jobs;
+    for(auto& input : inputs)
+        addJobs(input, options, jobs);
+
+    if(jobs.empty())
+    {
+        std::cerr << "No audio files found" << std::endl;
+        return 1;
+    }
+
+    if(! options.outputFolder.createDirectory())
+    {
+        std::cerr << "Couldn't create " << options.outputFolder.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    numThreads = juce::jmin(numThreads, (int) jobs.size());
+
+    std::vector<Result> results(jobs.size());
+    juce::CriticalSection printLock;
+    const auto start = Clock::now();
+
+    {
+        juce::ThreadPool pool(numThreads);
+
+        for(size_t i = 0; i < jobs.size(); ++i)
+        {
+            pool.addJob([&, i]
+            {
+                results[i] = renderFile(jobs[i], options);
+
+                const auto& result = results[i];
+                const juce::ScopedLock lock(printLock);
+
+                if(result.ok)
+                    std::cout << jobs[i].input.getFileName() << ": " << result.audioSeconds << " s ("
+                              << result.tailSeconds << " s tail) in " << result.wallSeconds << " s, "
+                              << result.audioSeconds / result.wallSeconds << "x real time" << std::endl;
+                else
+                {
+                    jobs[i].output.deleteFile();
+                    std::cerr << jobs[i].input.getFullPathName() << ": " << result.error << std::endl;
+                }
+            });
+        }
+
+        while(pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    const double wallSeconds = secondsSince(start);
+    double audioSeconds = 0.0;
+    int numFailed = 0;
+
+    for(auto& result : results)
+    {
+        audioSeconds += result.audioSeconds;
+        numFailed += result.ok ? 0 : 1;
+    }
+
+    std::cout << jobs.size() - (size_t) numFailed << " of " << jobs.size() << " files rendered, "
+              << audioSeconds << " s of audio in " << wallSeconds << " s on " << numThreads << " threads, "
+              << audioSeconds / wallSeconds << "x real time" << std::endl;
+
+    return numFailed == 0 ? 0 : 1;
+}
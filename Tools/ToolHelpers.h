@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    ToolHelpers.h
+    Created: 17 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// Shared by the command line tools: driving the processor outside a host
+// and reading / writing the audio files they work with.
+namespace ToolHelpers
+{
+    // value is in the parameter's plain range, as shown on the knob.
+    inline void setParameter(verbMASCHINEAudioProcessor& processor, const juce::String& id, float value)
+    {
+        if(auto* parameter = processor.apvts.getParameter(id))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    inline void prepare(verbMASCHINEAudioProcessor& processor, double sampleRate, int blockSize)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    // Runs input through a prepared processor blockSize samples at a time, in
+    // the precision of the buffer. The processor must have been prepared for
+    // that precision.
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType> render(verbMASCHINEAudioProcessor& processor,
+                                         const juce::AudioBuffer<SampleType>& input,
+                                         int blockSize)
+    {
+        juce::AudioBuffer<SampleType> output;
+        output.makeCopyOf(input);
+
+        juce::MidiBuffer midi;
+
+        for(int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            const int numSamples = juce::jmin(blockSize, output.getNumSamples() - start);
+            juce::AudioBuffer<SampleType> block(output.getArrayOfWritePointers(), output.getNumChannels(),
+                                                start, numSamples);
+            processor.processBlock(block, midi);
+        }
+
+        return output;
+    }
+
+    // Replaces file. Returns nullptr if it can't be written in that format.
+    inline std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& file, juce::AudioFormat& format,
+                                                                 double sampleRate, int numChannels, int bitsPerSample)
+    {
+        file.deleteFile();
+
+        std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+        if(stream == nullptr)
+            return nullptr;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(stream.get(), sampleRate,
+                                                                               (unsigned int) numChannels,
+                                                                               bitsPerSample, {}, 0));
+        if(writer != nullptr)
+            stream.release(); // now owned by the writer
+
+        return writer;
+    }
+
+    // 32 bit float WAV, so nothing is lost to dither or clipping.
+    inline bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+    {
+        juce::WavAudioFormat format;
+        auto writer = createWriter(file, format, sampleRate, buffer.getNumChannels(), 32);
+
+        return writer != nullptr && writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    inline bool readAudioFile(const juce::File& file, juce::AudioBuffer<float>& buffer, double& sampleRate)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if(reader == nullptr)
+            return false;
+
+        buffer.setSize((int) reader->numChannels, (int) reader->lengthInSamples);
+        sampleRate = reader->sampleRate;
+
+        return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+    }
+}